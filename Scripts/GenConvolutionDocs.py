@@ -38,6 +38,26 @@ StandardNames = [
     "LTE PBCH",
 ]
 
+# Only these standards' codes are tail-biting, so only their decoders use
+# maxTailBitingIterations.
+TailBitingStandardNames = [
+    "WiMax FCH",
+    "LTE PBCH",
+]
+
+TailBitingSetter = """
+ * |setter setMaxTailBitingIterations(maxTailBitingIterations)"""
+
+TailBitingParam = """
+ *
+ * |param maxTailBitingIterations[Max Tail-Biting Iterations]
+ * Tail-biting frames are decoded with repeated passes over the frame, each starting
+ * from where the last one ended, until the decoded path starts and ends in the same
+ * state or this many passes are made.
+ * |widget SpinBox(minimum=1)
+ * |default 4
+ * |preview disable"""
+
 # Note: we need the dummy functions, or Pothos will parse everything as a single
 # giant doc.
 EncoderTemplate = """
@@ -51,6 +71,32 @@ EncoderTemplate = """
  * |category /FEC/{1}
  * |keywords coder lte
  * |factory /fec/{2}_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void {2}();
 """
@@ -65,6 +111,71 @@ DecoderTemplate = """
  * |category /FEC/{1}
  * |keywords coder lte
  * |factory /fec/{2}_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID){3}
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable{4}
+ */
+void {2}();
+"""
+SoftDecoderTemplate = """
+/*
+ * |PothosDoc {0} Soft Decoder
+ *
+ * Takes in soft bits of encoded {0} data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/{1}
+ * |keywords coder lte soft llr
+ * |factory /fec/{2}_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void {2}();
 """
@@ -76,10 +187,21 @@ def convertStandardName(standardName):
 
     return convertedStandardName
 
+def formatDecoderDoc(standardName):
+    isTailBiting = standardName in TailBitingStandardNames
+
+    return DecoderTemplate.format(
+        standardName,
+        standardName.split(" ")[0],
+        convertStandardName(standardName),
+        TailBitingSetter if isTailBiting else "",
+        TailBitingParam if isTailBiting else "")
+
 def outputDocFile():
     encoderDocs = "".join([EncoderTemplate.format(standardName, standardName.split(" ")[0], convertStandardName(standardName)) for standardName in StandardNames])
-    decoderDocs = "".join([DecoderTemplate.format(standardName, standardName.split(" ")[0], convertStandardName(standardName)) for standardName in StandardNames])
-    fileContents = "{0}\n{1}\n{2}".format(Prefix, encoderDocs, decoderDocs)
+    decoderDocs = "".join([formatDecoderDoc(standardName) for standardName in StandardNames])
+    softDecoderDocs = "".join([SoftDecoderTemplate.format(standardName, standardName.split(" ")[0], convertStandardName(standardName)) for standardName in StandardNames])
+    fileContents = "{0}\n{1}\n{2}\n{3}".format(Prefix, encoderDocs, decoderDocs, softDecoderDocs)
 
     with open(OutputFile, "w") as f:
         f.write(fileContents)
@@ -0,0 +1,106 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ConvCodeConfig.hpp"
+#include "ConvolutionUtility.hpp"
+
+#include <Pothos/Exception.hpp>
+
+ConvCodeConfig::SPtr ConvCodeConfig::make(
+    const lte_conv_code& convCode,
+    size_t genArrLength)
+{
+    return std::make_shared<const ConvCodeConfig>(convCode, genArrLength);
+}
+
+ConvCodeConfig::ConvCodeConfig(
+    const lte_conv_code& convCode,
+    size_t genArrLength
+):
+    _convCode(convCode),
+    _genArrLength(genArrLength),
+    _encodedLength(0)
+{
+    if(_genArrLength > 4)
+    {
+        throw Pothos::InvalidArgumentException("Gen must be of size 0-4");
+    }
+
+    if(convCode.punc)
+    {
+        // TurboFEC expects puncture arrays to be terminated with -1, so we
+        // should be able to assume there's one somewhere in there.
+        for(const int* pPunc = convCode.punc; (*pPunc != -1); ++pPunc)
+        {
+            _puncture.emplace_back(*pPunc);
+        }
+        _puncture.emplace_back(-1);
+
+        _convCode.punc = _puncture.data();
+    }
+
+    validateConvCode(_convCode);
+    _encodedLength = calcConvEncodedLength(_convCode);
+}
+
+ConvCodeConfig::SPtr ConvCodeConfig::withLength(int length) const
+{
+    auto convCode = _convCode;
+    convCode.len = length;
+
+    return make(convCode, _genArrLength);
+}
+
+std::vector<unsigned> ConvCodeConfig::gen() const
+{
+    return std::vector<unsigned>(
+               _convCode.gen,
+               (_convCode.gen + _genArrLength));
+}
+
+std::vector<int> ConvCodeConfig::puncture() const
+{
+    // This removes the -1 terminator, since that's an implementation
+    // detail.
+    std::vector<int> ret;
+    if(!_puncture.empty())
+    {
+        ret = std::vector<int>(_puncture.begin(), (_puncture.end()-1));
+    }
+
+    return ret;
+}
+
+std::string ConvCodeConfig::terminationType() const
+{
+    return terminationTypeToString(_convCode.term);
+}
+
+ConvTermType terminationTypeFromString(const std::string& terminationType)
+{
+    if("Flush" == terminationType)            return ::CONV_TERM_FLUSH;
+    else if("Tail-biting" == terminationType) return ::CONV_TERM_TAIL_BITING;
+
+    throw Pothos::InvalidArgumentException("Invalid termination type: "+terminationType);
+}
+
+std::string terminationTypeToString(ConvTermType term)
+{
+    std::string ret;
+
+    switch(term)
+    {
+        case ::CONV_TERM_FLUSH:
+            ret = "Flush";
+            break;
+
+        case ::CONV_TERM_TAIL_BITING:
+            ret = "Tail-biting";
+            break;
+
+        default:
+            throw Pothos::AssertionViolationException("Invalid termination");
+    }
+
+    return ret;
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+extern "C"
+{
+#include <turbofec/conv.h>
+}
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// An immutable snapshot of a convolutional code. Blocks share these by
+// reference count, so the hot path can load the current code atomically
+// without contending with setters, which publish a new snapshot instead
+// of modifying the current one.
+class ConvCodeConfig
+{
+public:
+    using SPtr = std::shared_ptr<const ConvCodeConfig>;
+
+    // The puncture array is copied, so the given code's buffers don't need
+    // to outlive the snapshot. Throws if TurboFEC can't use the given code.
+    static SPtr make(const lte_conv_code& convCode, size_t genArrLength);
+
+    ConvCodeConfig(const lte_conv_code& convCode, size_t genArrLength);
+
+    // The code's puncture pointer points to our own storage.
+    ConvCodeConfig(const ConvCodeConfig&) = delete;
+    ConvCodeConfig& operator=(const ConvCodeConfig&) = delete;
+
+    // Returns a snapshot of the same code for blocks of the given length.
+    SPtr withLength(int length) const;
+
+    inline const lte_conv_code& convCode() const
+    {
+        return _convCode;
+    }
+
+    inline size_t genArrLength() const
+    {
+        return _genArrLength;
+    }
+
+    inline int encodedLength() const
+    {
+        return _encodedLength;
+    }
+
+    std::vector<unsigned> gen() const;
+
+    std::vector<int> puncture() const;
+
+    std::string terminationType() const;
+
+private:
+    lte_conv_code _convCode;
+    size_t _genArrLength;
+    int _encodedLength;
+
+    // For _convCode's pointer to point to
+    std::vector<int> _puncture;
+};
+
+using ConvTermType = decltype(lte_conv_code::term);
+
+// Converts between our string representation of termination types and
+// TurboFEC's, throwing on invalid values.
+ConvTermType terminationTypeFromString(const std::string& terminationType);
+
+std::string terminationTypeToString(ConvTermType term);
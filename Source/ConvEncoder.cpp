@@ -0,0 +1,213 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ConvEncoder.hpp"
+#include "ConvolutionUtility.hpp"
+
+#include <cstring>
+
+static constexpr size_t BitsPerByte = 8;
+
+// For each byte value, its bits expanded LSB-first into one byte each, so
+// unpunctured output can be written a byte of bits at a time.
+struct ExpandedBytes
+{
+    std::uint8_t bits[1U << BitsPerByte][BitsPerByte];
+
+    ExpandedBytes()
+    {
+        for(unsigned value = 0; value < (1U << BitsPerByte); ++value)
+        {
+            for(unsigned bit = 0; bit < BitsPerByte; ++bit)
+            {
+                bits[value][bit] = static_cast<std::uint8_t>((value >> bit) & 1U);
+            }
+        }
+    }
+};
+
+static const ExpandedBytes& getExpandedBytes()
+{
+    static const ExpandedBytes expandedBytes;
+    return expandedBytes;
+}
+
+ConvEncoder::ConvEncoder(const ConvCodeConfig::SPtr& config):
+    _config(config),
+    _trellis(config->convCode()),
+    _length(static_cast<size_t>(config->convCode().len)),
+    _isTailBiting(::CONV_TERM_TAIL_BITING == config->convCode().term),
+    _numSteps(_isTailBiting ? _length : (_length + config->convCode().k - 1)),
+    _punctureMask(getConvPunctureMask(config->convCode(), config->convCode().len)),
+    _byteNextStates(_trellis.numStates() << BitsPerByte),
+    _byteOutputs(_trellis.numStates() << BitsPerByte),
+    _byteKeepMasks(_length / BitsPerByte),
+    _encodeFcn(nullptr),
+    _encodePackedFcn(nullptr)
+{
+    const unsigned N = static_cast<unsigned>(_trellis.N());
+
+    switch(N)
+    {
+        case 2:
+            _encodeFcn = &ConvEncoder::_encode<false, 2>;
+            _encodePackedFcn = &ConvEncoder::_encode<true, 2>;
+            break;
+
+        case 3:
+            _encodeFcn = &ConvEncoder::_encode<false, 3>;
+            _encodePackedFcn = &ConvEncoder::_encode<true, 3>;
+            break;
+
+        case 4:
+            _encodeFcn = &ConvEncoder::_encode<false, 4>;
+            _encodePackedFcn = &ConvEncoder::_encode<true, 4>;
+            break;
+
+        default:
+            _encodeFcn = &ConvEncoder::_encode<false, 0>;
+            _encodePackedFcn = &ConvEncoder::_encode<true, 0>;
+            break;
+    }
+
+    for(unsigned startState = 0; startState < _trellis.numStates(); ++startState)
+    {
+        for(unsigned inputByte = 0; inputByte < (1U << BitsPerByte); ++inputByte)
+        {
+            unsigned state = startState;
+            std::uint32_t outputs = 0;
+
+            for(unsigned bit = 0; bit < BitsPerByte; ++bit)
+            {
+                const unsigned inputBit = (inputByte >> (BitsPerByte - 1 - bit)) & 1U;
+                const unsigned registerBit = _trellis.registerBit(state, inputBit);
+
+                outputs |= (_trellis.output(state, registerBit) << (bit * N));
+                state = _trellis.nextState(state, registerBit);
+            }
+
+            const auto index = (startState << BitsPerByte) | inputByte;
+            _byteNextStates[index] = static_cast<std::uint16_t>(state);
+            _byteOutputs[index] = outputs;
+        }
+    }
+
+    const size_t bitsPerByteStep = BitsPerByte * N;
+    for(size_t byte = 0; byte < _byteKeepMasks.size(); ++byte)
+    {
+        std::uint32_t keepMask = 0;
+        for(size_t bit = 0; bit < bitsPerByteStep; ++bit)
+        {
+            if(_punctureMask[(byte * bitsPerByteStep) + bit]) keepMask |= (1U << bit);
+        }
+
+        _byteKeepMasks[byte] = keepMask;
+    }
+}
+
+template <bool Packed>
+static inline unsigned readInputByte(const std::uint8_t* input, size_t byteIndex)
+{
+    if(Packed) return input[byteIndex];
+
+    const auto* bits = input + (byteIndex * BitsPerByte);
+
+    // Load all 8 bits at once, then gather them MSB-first into the top byte
+    // of the product, where no two partial products overlap. Compilers don't
+    // combine a loop over the bytes into this.
+    std::uint64_t bitBytes = 0;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    std::memcpy(&bitBytes, bits, sizeof(bitBytes));
+#else
+    for(size_t bit = 0; bit < BitsPerByte; ++bit)
+    {
+        bitBytes |= static_cast<std::uint64_t>(bits[bit]) << (bit * BitsPerByte);
+    }
+#endif
+
+    bitBytes &= 0x0101010101010101ULL;
+
+    return static_cast<unsigned>((bitBytes * 0x8040201008040201ULL) >> 56);
+}
+
+template <bool Packed, int FixedN>
+void ConvEncoder::_encode(const std::uint8_t* input, std::uint8_t* output) const
+{
+    const unsigned N = (FixedN > 0) ? FixedN : static_cast<unsigned>(_trellis.N());
+    const unsigned K = static_cast<unsigned>(_trellis.K());
+
+    // Tail-biting frames start in the state the last K-1 bits leave the
+    // encoder in, so they also end in it. Tail-biting is only valid for
+    // non-recursive codes, where the state is just the previous inputs.
+    unsigned state = 0;
+    if(_isTailBiting)
+    {
+        for(unsigned i = 0; i < (K - 1); ++i)
+        {
+            const size_t inputIndex = (_length - 1 - (i % _length)) % _length;
+            state |= readInputBit<Packed>(input, inputIndex) << (K - 2 - i);
+        }
+    }
+
+    const auto& expandedBytes = getExpandedBytes();
+
+    const size_t bitsPerByteStep = BitsPerByte * N;
+    const std::uint32_t allKept = (bitsPerByteStep < 32) ? ((1U << bitsPerByteStep) - 1) : 0xFFFFFFFFU;
+
+    for(size_t byte = 0; byte < _byteKeepMasks.size(); ++byte)
+    {
+        const auto index = (state << BitsPerByte) | readInputByte<Packed>(input, byte);
+        const auto outputs = _byteOutputs[index];
+        const auto keepMask = _byteKeepMasks[byte];
+
+        if(keepMask == allKept)
+        {
+            for(size_t outputByte = 0; outputByte < N; ++outputByte)
+            {
+                const auto value = (outputs >> (outputByte * BitsPerByte)) & 0xFFU;
+                std::memcpy(output, expandedBytes.bits[value], BitsPerByte);
+                output += BitsPerByte;
+            }
+        }
+        else
+        {
+            // Visit only the kept bits, lowest first.
+            for(auto remaining = keepMask; remaining; remaining &= (remaining - 1))
+            {
+                const auto bit = static_cast<unsigned>(__builtin_ctz(remaining));
+                *(output++) = static_cast<std::uint8_t>((outputs >> bit) & 1U);
+            }
+        }
+
+        state = _byteNextStates[index];
+    }
+
+    // Any bits past the last whole byte, as well as the tail of a flushed
+    // frame, are encoded one at a time.
+    size_t unpuncturedIndex = _byteKeepMasks.size() * bitsPerByteStep;
+    for(size_t step = _byteKeepMasks.size() * BitsPerByte; step < _numSteps; ++step)
+    {
+        // The tail of a flushed frame shifts zeros into the register,
+        // which for recursive codes means cancelling out the feedback.
+        const unsigned registerBit = (step < _length) ? _trellis.registerBit(state, readInputBit<Packed>(input, step)) : 0U;
+        const unsigned outputs = _trellis.output(state, registerBit);
+
+        for(unsigned i = 0; i < N; ++i, ++unpuncturedIndex)
+        {
+            if(_punctureMask[unpuncturedIndex]) *(output++) = static_cast<std::uint8_t>((outputs >> i) & 1U);
+        }
+
+        state = _trellis.nextState(state, registerBit);
+    }
+}
+
+void ConvEncoder::encode(const std::uint8_t* input, std::uint8_t* output) const
+{
+    (this->*_encodeFcn)(input, output);
+}
+
+void ConvEncoder::encodePacked(const std::uint8_t* input, std::uint8_t* output) const
+{
+    (this->*_encodePackedFcn)(input, output);
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "ConvCodeConfig.hpp"
+#include "ConvTrellis.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A table-driven convolutional encoder for a single code snapshot, walking
+// the same trellis as the in-tree decoders. This produces output identical
+// to lte_conv_encode, but supports any constraint length the decoders do.
+//
+// Rather than shifting one bit at a time through the generators, each
+// lookup advances the encoder by a byte of input, and puncturing is folded
+// into a precomputed mask of which of that byte's output bits are kept.
+// All tables are built on construction, and the encoding loop is
+// instantiated for each rate the standard codes use.
+class ConvEncoder
+{
+public:
+    using UPtr = std::unique_ptr<ConvEncoder>;
+
+    explicit ConvEncoder(const ConvCodeConfig::SPtr& config);
+
+    inline const ConvCodeConfig::SPtr& config() const
+    {
+        return _config;
+    }
+
+    // Encodes config()->convCode().len bits into config()->encodedLength()
+    // bits.
+    void encode(const std::uint8_t* input, std::uint8_t* output) const;
+
+    // As above, but reading the input bits MSB-first from
+    // ceil(config()->convCode().len / 8) bytes.
+    void encodePacked(const std::uint8_t* input, std::uint8_t* output) const;
+
+private:
+    using EncodeFcn = void(ConvEncoder::*)(const std::uint8_t*, std::uint8_t*) const;
+
+    ConvCodeConfig::SPtr _config;
+    ConvTrellis _trellis;
+
+    size_t _length;
+    bool _isTailBiting;
+    size_t _numSteps;
+
+    // Whether each unpunctured output bit is kept
+    std::vector<std::uint8_t> _punctureMask;
+
+    // Indexed by (state << 8) | inputByte, where the first input bit is the
+    // byte's MSB. Output i of the byte's jth bit is stored in bit (j*N)+i.
+    std::vector<std::uint16_t> _byteNextStates;
+    std::vector<std::uint32_t> _byteOutputs;
+
+    // For each whole input byte of the frame, which of its output bits are
+    // kept after puncturing, in the same layout as above
+    std::vector<std::uint32_t> _byteKeepMasks;
+
+    EncodeFcn _encodeFcn;
+    EncodeFcn _encodePackedFcn;
+
+    // FixedN is 0 to read the code's rate at runtime.
+    template <bool Packed, int FixedN>
+    void _encode(const std::uint8_t* input, std::uint8_t* output) const;
+};
@@ -0,0 +1,46 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ConvTrellis.hpp"
+
+static inline unsigned parity(unsigned value)
+{
+    return static_cast<unsigned>(__builtin_parity(value));
+}
+
+ConvTrellis::ConvTrellis(const lte_conv_code& convCode):
+    _N(convCode.n),
+    _K(convCode.k),
+    _numStates(1U << (convCode.k - 1)),
+    _isRecursive(convCode.rgen > 0),
+    _feedback(_numStates, 0),
+    _outputs(_numStates * 2, 0)
+{
+    const unsigned systematicGen = (1U << (_K - 1));
+
+    for(unsigned state = 0; state < _numStates; ++state)
+    {
+        // The state only holds previous register bits, so this ignores
+        // the recursive generator's tap on the incoming bit.
+        if(_isRecursive) _feedback[state] = static_cast<std::uint8_t>(parity(state & convCode.rgen));
+
+        for(unsigned registerBit = 0; registerBit < 2; ++registerBit)
+        {
+            const unsigned reg = (registerBit << (_K - 1)) | state;
+
+            unsigned output = 0;
+            for(int i = 0; i < _N; ++i)
+            {
+                const unsigned gen = convCode.gen[i];
+
+                unsigned outputBit = 0;
+                if(_isRecursive && (gen == systematicGen)) outputBit = this->inputBit(state, registerBit);
+                else                                       outputBit = parity(reg & gen);
+
+                output |= (outputBit << i);
+            }
+
+            _outputs[(state << 1) | registerBit] = static_cast<std::uint8_t>(output);
+        }
+    }
+}
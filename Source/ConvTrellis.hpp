@@ -0,0 +1,80 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+extern "C"
+{
+#include <turbofec/conv.h>
+}
+
+#include <cstdint>
+#include <vector>
+
+// The trellis of a convolutional code, derived from its generator
+// polynomials using TurboFEC's conventions.
+//
+// The shift register moves right, so the newest bit enters at bit K-1 of
+// the register, and a state is the register's low K-1 bits. For recursive
+// codes, the bit entering the register is the input XORed with the feedback
+// from the current state, and a generator with only bit K-1 set marks a
+// systematic output.
+class ConvTrellis
+{
+public:
+    explicit ConvTrellis(const lte_conv_code& convCode);
+
+    inline int N() const
+    {
+        return _N;
+    }
+
+    inline int K() const
+    {
+        return _K;
+    }
+
+    inline unsigned numStates() const
+    {
+        return _numStates;
+    }
+
+    inline bool isRecursive() const
+    {
+        return _isRecursive;
+    }
+
+    // The bit shifted into the register when the given input bit is
+    // encoded in the given state.
+    inline unsigned registerBit(unsigned state, unsigned inputBit) const
+    {
+        return (inputBit ^ _feedback[state]);
+    }
+
+    inline unsigned nextState(unsigned state, unsigned registerBit) const
+    {
+        return ((registerBit << (_K - 2)) | (state >> 1));
+    }
+
+    // The input bit that shifts the given bit into the register in the
+    // given state.
+    inline unsigned inputBit(unsigned state, unsigned registerBit) const
+    {
+        return (registerBit ^ _feedback[state]);
+    }
+
+    // Output i is stored in bit i.
+    inline unsigned output(unsigned state, unsigned registerBit) const
+    {
+        return _outputs[(state << 1) | registerBit];
+    }
+
+private:
+    int _N;
+    int _K;
+    unsigned _numStates;
+    bool _isRecursive;
+
+    std::vector<std::uint8_t> _feedback;
+    std::vector<std::uint8_t> _outputs;
+};
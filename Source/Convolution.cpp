@@ -91,34 +91,53 @@ class Convolution: public ConvolutionBase
 public:
     static Pothos::Block* make(const std::string& standard, bool isEncoder)
     {
-        auto mapIter = ConvCodeMap.find(standard);
-        if(ConvCodeMap.end() != mapIter)
-        {
-            return new Convolution(
-                           standard,
-                           const_cast<lte_conv_code*>(mapIter->second),
-                           isEncoder);
-        }
+        return makeWithOutputDType(standard, isEncoder, "uint8");
+    }
 
-        throw Pothos::InvalidArgumentException("Invalid standard: "+standard);
+    static Pothos::Block* makeSoftDecoder(const std::string& standard, const Pothos::DType& dtype)
+    {
+        return makeWithOutputDType(standard, false, dtype);
     }
 
-    Convolution(const std::string& standard, lte_conv_code* pConvCode, bool isEncoder):
-        ConvolutionBase(pConvCode, isEncoder),
-        _standard(standard)
+    static Pothos::Block* makeWithOutputDType(
+        const std::string& standard,
+        bool isEncoder,
+        const Pothos::DType& outputDType)
     {
-        auto genArrLengthsIter = GenArrLengthsMap.find(_standard);
-        if(GenArrLengthsMap.end() != genArrLengthsIter)
+        auto mapIter = ConvCodeMap.find(standard);
+        if(ConvCodeMap.end() == mapIter)
         {
-            _genArrLength = genArrLengthsIter->second;
+            throw Pothos::InvalidArgumentException("Invalid standard: "+standard);
         }
-        else
+
+        auto genArrLengthsIter = GenArrLengthsMap.find(standard);
+        if(GenArrLengthsMap.end() == genArrLengthsIter)
         {
             throw Pothos::AssertionViolationException(
-                      "Convolution::Convolution",
-                      "Could not find GenArrLengthsMap entry for "+_standard);
+                      "Convolution::make",
+                      "Could not find GenArrLengthsMap entry for "+standard);
         }
 
+        return new Convolution(
+                       standard,
+                       *mapIter->second,
+                       genArrLengthsIter->second,
+                       isEncoder,
+                       outputDType);
+    }
+
+    // These codes are read-only, so the snapshot set here is the only
+    // one this block will ever use.
+    Convolution(
+        const std::string& standard,
+        const lte_conv_code& convCode,
+        size_t genArrLength,
+        bool isEncoder,
+        const Pothos::DType& outputDType
+    ):
+        ConvolutionBase(convCode, genArrLength, isEncoder, outputDType),
+        _standard(standard)
+    {
         this->registerCall(this, POTHOS_FCN_TUPLE(Convolution, standard));
     }
 
@@ -161,11 +180,22 @@ static std::vector<Pothos::BlockRegistry> _getConvolutionBlockRegistries()
                        .bind(isEncoder, 1));
     };
 
+    auto convCodeMapPairToSoftDecoderBlockRegistry = [&](const ConvCodeMapPair& mapPair) -> Pothos::BlockRegistry
+    {
+        const auto& standardName = mapPair.first;
+        const auto convertedStandardName = convertStandardName(standardName);
+
+        return Pothos::BlockRegistry(
+                   ("/fec/"+convertedStandardName+"_soft_decoder"),
+                   Pothos::Callable(&Convolution::makeSoftDecoder)
+                       .bind(standardName, 0));
+    };
+
     auto convCodeMapPairToEncoderBlockRegistry = std::bind(convCodeMapPairToBlockRegistry, std::placeholders::_1, true);
     auto convCodeMapPairToDecoderBlockRegistry = std::bind(convCodeMapPairToBlockRegistry, std::placeholders::_1, false);
 
     std::vector<Pothos::BlockRegistry> blockRegistries;
-    blockRegistries.reserve(ConvCodeMap.size()*2);
+    blockRegistries.reserve(ConvCodeMap.size()*3);
 
     std::transform(
         ConvCodeMap.begin(),
@@ -177,6 +207,11 @@ static std::vector<Pothos::BlockRegistry> _getConvolutionBlockRegistries()
         ConvCodeMap.end(),
         std::back_inserter(blockRegistries),
         convCodeMapPairToDecoderBlockRegistry);
+    std::transform(
+        ConvCodeMap.begin(),
+        ConvCodeMap.end(),
+        std::back_inserter(blockRegistries),
+        convCodeMapPairToSoftDecoderBlockRegistry);
 
     return blockRegistries;
 }
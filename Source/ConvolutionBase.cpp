@@ -2,23 +2,68 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "ConvolutionBase.hpp"
-#include "Utility.hpp"
-
-#include <Poco/Format.h>
-#include <Poco/NumberFormatter.h>
+#include "ConvolutionUtility.hpp"
 
 #include <Pothos/Exception.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <string>
+
+// Processing multiple frames per call amortizes the scheduler overhead,
+// which can exceed the cost of the coding itself for short frames.
+static constexpr size_t DefaultMaxFramesPerWork = 64;
+
+// Only this many lengths of label-delimited frames have coders cached at
+// once, as each holds tables sized by the length.
+static constexpr size_t MaxCachedBlockLengths = 16;
+
+// Label-delimited frames can't be longer than this many uncoded bits, so a
+// bad label can't make us build coders for an arbitrarily long frame.
+static constexpr size_t MaxBlockLength = 65536;
+
+// The size of a frame of uncoded bits, which are the encoder's input and
+// the decoder's output.
+static size_t getDataFrameSize(const ConvCodeConfig& config, bool packed)
+{
+    const auto length = static_cast<size_t>(config.convCode().len);
 
-ConvolutionBase::ConvolutionBase(lte_conv_code* pConvCode, bool isEncoder):
+    return packed ? ((length + 7) / 8) : length;
+}
+
+ConvolutionBase::ConvolutionBase(
+    const lte_conv_code& convCode,
+    size_t genArrLength,
+    bool isEncoder,
+    const Pothos::DType& outputDType
+):
     Pothos::Block(),
-    _pConvCode(pConvCode),
-    _genArrLength(4),
-    _isEncoder(isEncoder)
+    _isEncoder(isEncoder),
+    _isSoftDecoder(!isEncoder && (outputDType != Pothos::DType("uint8"))),
+    _isFloatOutput(outputDType == Pothos::DType("float32")),
+    _maxFramesPerWork(DefaultMaxFramesPerWork),
+    _packed(false),
+    _maxTailBitingIterations(DefaultMaxTailBitingIterations),
+    _numTailBitingFrames(0),
+    _numTailBitingStateMatches(0),
+    _numTailBitingIterations(0),
+    _convCodeConfig(ConvCodeConfig::make(convCode, genArrLength)),
+    _blockStartID(std::make_shared<const std::string>())
 {
+    if(_isEncoder && (outputDType != Pothos::DType("uint8")))
+    {
+        throw Pothos::InvalidArgumentException("Encoders only support uint8 output");
+    }
+    if(_isSoftDecoder && !_isFloatOutput && (outputDType != Pothos::DType("int8")))
+    {
+        throw Pothos::InvalidArgumentException(
+                  "Soft decoders only support int8 and float32 output",
+                  outputDType.name());
+    }
+
     this->setupInput(0, (_isEncoder ? "uint8" : "int8"));
-    this->setupOutput(0, "uint8");
+    this->setupOutput(0, outputDType);
 
     this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, N));
     this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, K));
@@ -27,6 +72,17 @@ ConvolutionBase::ConvolutionBase(lte_conv_code* pConvCode, bool isEncoder):
     this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, gen));
     this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, puncture));
     this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, terminationType));
+    this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, encodedLength));
+    this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, maxFramesPerWork));
+    this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, setMaxFramesPerWork));
+    this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, packed));
+    this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, setPacked));
+    this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, blockStartID));
+    this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, setBlockStartID));
+    this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, maxTailBitingIterations));
+    this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, setMaxTailBitingIterations));
+    this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, stateMatchRate));
+    this->registerCall(this, POTHOS_FCN_TUPLE(ConvolutionBase, averageIterations));
 
     this->registerProbe("N");
     this->registerProbe("K");
@@ -35,195 +91,571 @@ ConvolutionBase::ConvolutionBase(lte_conv_code* pConvCode, bool isEncoder):
     this->registerProbe("gen");
     this->registerProbe("puncture");
     this->registerProbe("terminationType");
+    this->registerProbe("encodedLength");
+    this->registerProbe("maxFramesPerWork");
+    this->registerProbe("packed");
+    this->registerProbe("blockStartID");
+    this->registerProbe("maxTailBitingIterations");
+    this->registerProbe("stateMatchRate");
+    this->registerProbe("averageIterations");
+
+    this->registerSignal("maxFramesPerWorkChanged");
+    this->registerSignal("packedChanged");
+    this->registerSignal("blockStartIDChanged");
+    this->registerSignal("maxTailBitingIterationsChanged");
 }
 
 ConvolutionBase::~ConvolutionBase() {}
 
 void ConvolutionBase::activate()
 {
-    this->_updatePortReserves();
+    const auto config = this->_getConvCodeConfig();
+    this->_updatePortReserves(*config);
+
+    _numTailBitingFrames = 0;
+    _numTailBitingStateMatches = 0;
+    _numTailBitingIterations = 0;
+
+    if(_isEncoder)
+    {
+        _convEncoder.reset(new ConvEncoder(config));
+    }
+    else if(_isSoftDecoder)
+    {
+        _maxLogMAPDecoder.reset(new MaxLogMAPConvDecoder(config));
+    }
+    else
+    {
+        // The multi-frame decoder's decisions are sized for every lane, so
+        // it's only built once enough frames are queued to use it.
+        _viterbiDecoder.reset(new ViterbiDecoder(config));
+    }
 }
 
 int ConvolutionBase::N() const
 {
-    Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
-    return _pConvCode->n;
+    return this->_getConvCodeConfig()->convCode().n;
 }
 
 int ConvolutionBase::K() const
 {
-    Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
-    return _pConvCode->k;
+    return this->_getConvCodeConfig()->convCode().k;
 }
 
 int ConvolutionBase::length() const
 {
-    Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
-    return _pConvCode->len;
+    return this->_getConvCodeConfig()->convCode().len;
 }
 
 unsigned ConvolutionBase::rgen() const
 {
-    Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
-    return _pConvCode->rgen;
+    return this->_getConvCodeConfig()->convCode().rgen;
 }
 
 std::vector<unsigned> ConvolutionBase::gen() const
 {
-    Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
-    return this->_gen();
+    return this->_getConvCodeConfig()->gen();
 }
 
 std::vector<int> ConvolutionBase::puncture() const
 {
-    Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
-    return this->_punctureFunc();
+    return this->_getConvCodeConfig()->puncture();
 }
 
 std::string ConvolutionBase::terminationType() const
 {
-    Poco::FastMutex::ScopedLock lock(_convCodeMutex);
+    return this->_getConvCodeConfig()->terminationType();
+}
 
-    return this->_terminationType();
+int ConvolutionBase::encodedLength() const
+{
+    return this->_getConvCodeConfig()->encodedLength();
 }
 
-void ConvolutionBase::work()
+size_t ConvolutionBase::maxFramesPerWork() const
+{
+    return _maxFramesPerWork;
+}
+
+void ConvolutionBase::setMaxFramesPerWork(size_t maxFramesPerWork)
 {
-    Poco::FastMutex::ScopedLock lock(_convCodeMutex);
+    if(0 == maxFramesPerWork)
+    {
+        throw Pothos::InvalidArgumentException("Max frames per work must be positive");
+    }
+
+    _maxFramesPerWork = maxFramesPerWork;
 
-    if(_isEncoder) this->_encoderWork();
-    else           this->_decoderWork();
+    this->emitSignal("maxFramesPerWorkChanged", maxFramesPerWork);
 }
 
-std::vector<unsigned> ConvolutionBase::_gen() const
+bool ConvolutionBase::packed() const
 {
-    return std::vector<unsigned>(
-              _pConvCode->gen,
-              (_pConvCode->gen + _genArrLength));
+    return _packed;
 }
 
-std::vector<int> ConvolutionBase::_punctureFunc() const
+void ConvolutionBase::setPacked(bool packed)
 {
-    std::vector<int> ret;
-    if(_pConvCode->punc)
+    if(packed && _isSoftDecoder)
+    {
+        throw Pothos::InvalidArgumentException("Soft decoder output cannot be packed");
+    }
+
     {
-        // Since we manage the underlying buffer, we should be able to assume
-        // that there's a -1 somewhere in there.
-        size_t negOnePos = 0;
-        while(_pConvCode->punc[negOnePos] != -1) ++negOnePos;
+        Poco::FastMutex::ScopedLock lock(_convCodeMutex);
 
-        // This removes the -1 terminator, since that's an implementation
-        // detail.
-        ret = std::vector<int>(_pConvCode->punc, _pConvCode->punc+negOnePos);
+        _packed = packed;
+        this->_updatePortReserves(*this->_getConvCodeConfig());
     }
 
-    return ret;
+    this->emitSignal("packedChanged", packed);
 }
 
-std::string ConvolutionBase::_terminationType() const
+std::string ConvolutionBase::blockStartID() const
 {
-    std::string ret;
+    return *this->_getBlockStartID();
+}
 
-    switch(_pConvCode->term)
+void ConvolutionBase::setBlockStartID(const std::string& blockStartID)
+{
     {
-        case ::CONV_TERM_FLUSH:
-            ret = "Flush";
-            break;
+        Poco::FastMutex::ScopedLock lock(_convCodeMutex);
 
-        case ::CONV_TERM_TAIL_BITING:
-            ret = "Tail-biting";
-            break;
+        std::atomic_store(&_blockStartID, std::make_shared<const std::string>(blockStartID));
+        this->_updatePortReserves(*this->_getConvCodeConfig());
+    }
 
-        default:
-            throw Pothos::AssertionViolationException("Invalid termination");
+    this->emitSignal("blockStartIDChanged", blockStartID);
+}
+
+size_t ConvolutionBase::maxTailBitingIterations() const
+{
+    return _maxTailBitingIterations;
+}
+
+void ConvolutionBase::setMaxTailBitingIterations(size_t maxTailBitingIterations)
+{
+    if(0 == maxTailBitingIterations)
+    {
+        throw Pothos::InvalidArgumentException("The maximum tail-biting iterations must be positive");
     }
 
-    return ret;
+    _maxTailBitingIterations = maxTailBitingIterations;
+
+    this->emitSignal("maxTailBitingIterationsChanged", maxTailBitingIterations);
+}
+
+double ConvolutionBase::stateMatchRate() const
+{
+    const size_t numFrames = _numTailBitingFrames;
+
+    return (numFrames > 0) ? (double(_numTailBitingStateMatches) / double(numFrames)) : 0.0;
+}
+
+double ConvolutionBase::averageIterations() const
+{
+    const size_t numFrames = _numTailBitingFrames;
+
+    return (numFrames > 0) ? (double(_numTailBitingIterations) / double(numFrames)) : 0.0;
 }
 
-// The logic to determine the expected output size is somewhat
-// convoluted (no pun intended), so we'll run the underlying
-// function on dummy data and note the output length. This isn't
-// ideal, but the function *should* be fast enough so this isn't
-// noticeable, since it only happens on construction and when
-// a field is changed.
-void ConvolutionBase::_updatePortReserves()
+void ConvolutionBase::propagateLabels(const Pothos::InputPort* input)
 {
-    // Don't instantiate our test vectors each time.
-    if(_expectedEncodeCalcInputVec.empty())
+    const auto blockStartID = this->_getBlockStartID();
+    if(!blockStartID->empty())
     {
-        _expectedEncodeCalcInputVec.resize(_pConvCode->len);
+        // We post our own block start labels for each frame we output.
+        for(const auto& label: input->labels())
+        {
+            if(label.id != *blockStartID) this->output(0)->postLabel(label);
+        }
     }
+    else Pothos::Block::propagateLabels(input);
+}
 
-    // This should be more than enough.
-    _expectedEncodeCalcOutputVec.resize(_pConvCode->len * 500);
+void ConvolutionBase::work()
+{
+    // Hold a reference to the current snapshot for the duration of this
+    // call, so a setter publishing a new one doesn't affect us mid-frame.
+    const auto config = this->_getConvCodeConfig();
+    const auto blockStartID = this->_getBlockStartID();
+
+    if(!blockStartID->empty()) this->_blockIDWork(config, *blockStartID);
+    else if(_isEncoder)        this->_encoderWork(config);
+    else if(!_isSoftDecoder)   this->_decoderWork(config);
+    else if(_isFloatOutput)    this->_softDecoderWork<float>(config);
+    else                       this->_softDecoderWork<std::int8_t>(config);
+}
 
-    int encodeRet = ::lte_conv_encode(
-                        _pConvCode,
-                        _expectedEncodeCalcInputVec.data(),
-                        _expectedEncodeCalcOutputVec.data());
-    throwOnErrCode(encodeRet);
+ConvCodeConfig::SPtr ConvolutionBase::_getConvCodeConfig() const
+{
+    return std::atomic_load(&_convCodeConfig);
+}
 
-    _expectedEncodeSize = encodeRet;
+std::shared_ptr<const std::string> ConvolutionBase::_getBlockStartID() const
+{
+    return std::atomic_load(&_blockStartID);
+}
+
+void ConvolutionBase::_setConvCodeConfig(
+    const lte_conv_code& convCode,
+    size_t genArrLength)
+{
+    auto config = ConvCodeConfig::make(convCode, genArrLength);
+    this->_updatePortReserves(*config);
 
-    this->input(0)->setReserve(static_cast<size_t>(this->_isEncoder ? _pConvCode->len : _expectedEncodeSize));
-    this->output(0)->setReserve(static_cast<size_t>(this->_isEncoder ? _expectedEncodeSize :_pConvCode->len));
+    std::atomic_store(&_convCodeConfig, config);
 }
 
-void ConvolutionBase::_encoderWork()
+void ConvolutionBase::_updatePortReserves(const ConvCodeConfig& config)
+{
+    // Label-delimited frames set these per frame, as each frame's length
+    // isn't known until its label arrives.
+    if(!this->_getBlockStartID()->empty())
+    {
+        this->input(0)->setReserve(0);
+        this->output(0)->setReserve(0);
+        return;
+    }
+
+    const auto dataFrameSize = getDataFrameSize(config, _packed);
+    const auto encodedLength = static_cast<size_t>(config.encodedLength());
+
+    this->input(0)->setReserve(_isEncoder ? dataFrameSize : encodedLength);
+    this->output(0)->setReserve(_isEncoder ? encodedLength : dataFrameSize);
+}
+
+// Determine how many complete frames can be processed with the input
+// available and the output space we have, up to the configured maximum.
+size_t ConvolutionBase::_numFramesToProcess(
+    size_t inputFrameSize,
+    size_t outputFrameSize) const
+{
+    const auto numInputFrames = this->input(0)->elements() / inputFrameSize;
+    const auto numOutputFrames = this->output(0)->elements() / outputFrameSize;
+
+    return std::min<size_t>({numInputFrames, numOutputFrames, _maxFramesPerWork});
+}
+
+void ConvolutionBase::_encoderWork(const ConvCodeConfig::SPtr& config)
 {
     auto input = this->input(0);
     auto output = this->output(0);
 
-    if((input->elements() < static_cast<size_t>(_pConvCode->len)) ||
-       (output->elements() < static_cast<size_t>(_expectedEncodeSize)))
+    const bool packed = _packed;
+    const auto inputFrameSize = getDataFrameSize(*config, packed);
+    const auto outputFrameSize = static_cast<size_t>(config->encodedLength());
+
+    const auto numFrames = this->_numFramesToProcess(inputFrameSize, outputFrameSize);
+    if(0 == numFrames) return;
+
+    const auto* inBuff = input->buffer().as<const std::uint8_t*>();
+    auto* outBuff = output->buffer().as<std::uint8_t*>();
+
+    if(!_convEncoder || (_convEncoder->config() != config))
     {
-        return;
+        _convEncoder.reset(new ConvEncoder(config));
     }
 
-    int encodeRet = ::lte_conv_encode(
-                         _pConvCode,
-                         input->buffer(),
-                         output->buffer());
-    throwOnErrCode(encodeRet);
+    for(size_t frame = 0; frame < numFrames; ++frame)
+    {
+        if(packed) _convEncoder->encodePacked(inBuff, outBuff);
+        else       _convEncoder->encode(inBuff, outBuff);
 
-    if(encodeRet != _expectedEncodeSize)
+        inBuff += inputFrameSize;
+        outBuff += outputFrameSize;
+    }
+
+    input->consume(numFrames * inputFrameSize);
+    output->produce(numFrames * outputFrameSize);
+}
+
+void ConvolutionBase::_decoderWork(const ConvCodeConfig::SPtr& config)
+{
+    auto input = this->input(0);
+    auto output = this->output(0);
+
+    const bool packed = _packed;
+    const auto inputFrameSize = static_cast<size_t>(config->encodedLength());
+    const auto outputFrameSize = getDataFrameSize(*config, packed);
+
+    const auto numFrames = this->_numFramesToProcess(inputFrameSize, outputFrameSize);
+    if(0 == numFrames) return;
+
+    const auto* inBuff = input->buffer().as<const std::int8_t*>();
+    auto* outBuff = output->buffer().as<std::uint8_t*>();
+
+    constexpr size_t numLanes = MultiFrameViterbiDecoder::NumLanes;
+    size_t frame = 0;
+
+    if(numFrames >= numLanes)
+    {
+        if(!_multiFrameViterbiDecoder || (_multiFrameViterbiDecoder->config() != config))
+        {
+            _multiFrameViterbiDecoder.reset(new MultiFrameViterbiDecoder(config));
+        }
+        _multiFrameViterbiDecoder->setMaxTailBitingIterations(_maxTailBitingIterations);
+
+        for(; (frame + numLanes) <= numFrames; frame += numLanes)
+        {
+            if(packed) _multiFrameViterbiDecoder->decodePacked(inBuff, outBuff);
+            else       _multiFrameViterbiDecoder->decode(inBuff, outBuff);
+
+            inBuff += (numLanes * inputFrameSize);
+            outBuff += (numLanes * outputFrameSize);
+        }
+
+        this->_addTailBitingStats(_multiFrameViterbiDecoder->takeTailBitingStats());
+    }
+
+    if(frame < numFrames)
     {
-        throw Pothos::AssertionViolationException(
-                  "lte_conv_encode returned an unexpected output length",
-                  Poco::format(
-                      "Expected %s, got %s",
-                      Poco::NumberFormatter::format(encodeRet),
-                      Poco::NumberFormatter::format(_expectedEncodeSize)));
+        if(!_viterbiDecoder || (_viterbiDecoder->config() != config))
+        {
+            _viterbiDecoder.reset(new ViterbiDecoder(config));
+        }
+        _viterbiDecoder->setMaxTailBitingIterations(_maxTailBitingIterations);
+
+        for(; frame < numFrames; ++frame)
+        {
+            if(packed) _viterbiDecoder->decodePacked(inBuff, outBuff);
+            else       _viterbiDecoder->decode(inBuff, outBuff);
+
+            inBuff += inputFrameSize;
+            outBuff += outputFrameSize;
+        }
+
+        this->_addTailBitingStats(_viterbiDecoder->takeTailBitingStats());
     }
 
-    input->consume(_pConvCode->len);
-    output->produce(_expectedEncodeSize);
+    input->consume(numFrames * inputFrameSize);
+    output->produce(numFrames * outputFrameSize);
 }
 
-void ConvolutionBase::_decoderWork()
+// Flushed frames don't count towards the totals.
+void ConvolutionBase::_addTailBitingStats(const TailBitingStats& stats)
+{
+    _numTailBitingFrames += stats.numFrames;
+    _numTailBitingStateMatches += stats.numStateMatches;
+    _numTailBitingIterations += stats.numIterations;
+}
+
+template <typename T>
+void ConvolutionBase::_softDecoderWork(const ConvCodeConfig::SPtr& config)
 {
     auto input = this->input(0);
     auto output = this->output(0);
 
-    if((input->elements() < static_cast<size_t>(_expectedEncodeSize)) ||
-       (output->elements() < static_cast<size_t>(_pConvCode->len)))
+    const auto inputFrameSize = static_cast<size_t>(config->encodedLength());
+    const auto outputFrameSize = static_cast<size_t>(config->convCode().len);
+
+    const auto numFrames = this->_numFramesToProcess(inputFrameSize, outputFrameSize);
+    if(0 == numFrames) return;
+
+    if(!_maxLogMAPDecoder || (_maxLogMAPDecoder->config() != config))
     {
-        return;
+        _maxLogMAPDecoder.reset(new MaxLogMAPConvDecoder(config));
+    }
+
+    const auto* inBuff = input->buffer().as<const std::int8_t*>();
+    auto* outBuff = output->buffer().as<T*>();
+
+    // Any lanes past the last frame are left idle.
+    constexpr size_t numLanes = MaxLogMAPConvDecoder::NumLanes;
+    for(size_t frame = 0; frame < numFrames; frame += numLanes)
+    {
+        const auto numLaneFrames = std::min(numLanes, (numFrames - frame));
+        _maxLogMAPDecoder->decode(inBuff, numLaneFrames, outBuff);
+
+        inBuff += (numLaneFrames * inputFrameSize);
+        outBuff += (numLaneFrames * outputFrameSize);
+    }
+
+    input->consume(numFrames * inputFrameSize);
+    output->produce(numFrames * outputFrameSize);
+}
+
+// Codes frames that start at block start labels, each of the length in
+// bits given by its label's data, or of the configured length if it has
+// none. Encoders take the uncoded length, and decoders the encoded length,
+// which is the length on the input port either way. Each output frame is
+// labeled the same way, with its length on the output port.
+void ConvolutionBase::_blockIDWork(
+    const ConvCodeConfig::SPtr& config,
+    const std::string& blockStartID)
+{
+    auto input = this->input(0);
+    auto output = this->output(0);
+
+    const bool packed = _packed;
+    const auto numInputElems = input->elements();
+    const auto numOutputElems = output->elements();
+
+    const auto* inBuff = input->buffer().as<const std::uint8_t*>();
+    auto* outBuff = output->buffer().as<std::uint8_t*>();
+    const auto inputElemSize = input->dtype().size();
+    const auto outputElemSize = output->dtype().size();
+
+    size_t inputIndex = 0;
+    size_t outputIndex = 0;
+    size_t numFrames = 0;
+
+    size_t inputReserve = 0;
+    size_t outputReserve = 0;
+
+    // Anything after the last frame isn't part of one, unless we stop
+    // before reaching the next frame.
+    bool dropRemaining = true;
+
+    for(const auto& label: input->labels())
+    {
+        if((label.id != blockStartID) || (label.index < inputIndex)) continue;
+        if(label.index >= numInputElems) break;
+
+        // Anything before this frame isn't part of one.
+        inputIndex = label.index;
+
+        if(numFrames >= _maxFramesPerWork)
+        {
+            dropRemaining = false;
+            break;
+        }
+
+        const auto length = this->_getBlockLength(*config, label);
+        auto& coders = this->_getBlockCoders(config, length);
+
+        const auto dataFrameSize = getDataFrameSize(*coders.config, packed);
+        const auto encodedLength = static_cast<size_t>(coders.config->encodedLength());
+        const auto inputFrameSize = _isEncoder ? dataFrameSize : encodedLength;
+        const auto outputFrameSize = _isEncoder ? encodedLength : dataFrameSize;
+
+        // Wait until we have the whole frame and room to output it.
+        if((numInputElems - inputIndex) < inputFrameSize) inputReserve = inputFrameSize;
+        if((numOutputElems - outputIndex) < outputFrameSize) outputReserve = outputFrameSize;
+        if((inputReserve > 0) || (outputReserve > 0))
+        {
+            dropRemaining = false;
+            break;
+        }
+
+        this->_codeBlock(
+            coders,
+            inBuff + (inputIndex * inputElemSize),
+            outBuff + (outputIndex * outputElemSize),
+            packed);
+
+        const size_t outputLength = _isEncoder ? encodedLength : static_cast<size_t>(length);
+        output->postLabel(blockStartID, outputLength, outputIndex);
+
+        inputIndex += inputFrameSize;
+        outputIndex += outputFrameSize;
+        ++numFrames;
+    }
+
+    // If we're waiting on a frame, it will start at the front of the buffer
+    // the next time we're called.
+    input->consume(dropRemaining ? numInputElems : inputIndex);
+    if(outputIndex > 0) output->produce(outputIndex);
+
+    input->setReserve(inputReserve);
+    output->setReserve(outputReserve);
+}
+
+int ConvolutionBase::_getBlockLength(
+    const ConvCodeConfig& config,
+    const Pothos::Label& label) const
+{
+    if(!label.data.canConvert(typeid(size_t)))
+    {
+        return config.convCode().len;
     }
 
-    int decodeRet = ::lte_conv_decode(
-                         _pConvCode,
-                         input->buffer(),
-                         output->buffer());
-    throwOnErrCode(decodeRet);
+    const auto labelLength = label.data.convert<size_t>();
+    if(labelLength > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        throw Pothos::InvalidArgumentException(
+                  "Block length too large",
+                  std::to_string(labelLength));
+    }
 
-    input->consume(_expectedEncodeSize);
-    output->produce(_pConvCode->len);
+    auto length = static_cast<int>(labelLength);
+    if(!_isEncoder)
+    {
+        length = calcConvDataLength(config.convCode(), length);
+        if(length < 1)
+        {
+            throw Pothos::InvalidArgumentException(
+                      "No block length encodes to the given length",
+                      std::to_string(labelLength));
+        }
+    }
+    if(static_cast<size_t>(length) > MaxBlockLength)
+    {
+        throw Pothos::InvalidArgumentException(
+                  "Block length too large. Max block length: " + std::to_string(MaxBlockLength),
+                  std::to_string(length));
+    }
+
+    return length;
+}
+
+ConvolutionBase::BlockCoders& ConvolutionBase::_getBlockCoders(
+    const ConvCodeConfig::SPtr& config,
+    int length)
+{
+    if(_blockCodersSource != config)
+    {
+        _blockCoders.clear();
+        _blockCodersSource = config;
+    }
+
+    auto iter = _blockCoders.find(length);
+    if(iter != _blockCoders.end()) return iter->second;
+
+    if(_blockCoders.size() >= MaxCachedBlockLengths) _blockCoders.clear();
+
+    auto& coders = _blockCoders[length];
+    coders.config = (length == config->convCode().len) ? config : config->withLength(length);
+
+    return coders;
+}
+
+void ConvolutionBase::_codeBlock(
+    BlockCoders& coders,
+    const void* input,
+    void* output,
+    bool packed)
+{
+    if(_isEncoder)
+    {
+        if(!coders.convEncoder) coders.convEncoder.reset(new ConvEncoder(coders.config));
+
+        const auto* inBuff = static_cast<const std::uint8_t*>(input);
+        auto* outBuff = static_cast<std::uint8_t*>(output);
+
+        if(packed) coders.convEncoder->encodePacked(inBuff, outBuff);
+        else       coders.convEncoder->encode(inBuff, outBuff);
+    }
+    else if(!_isSoftDecoder)
+    {
+        if(!coders.viterbiDecoder) coders.viterbiDecoder.reset(new ViterbiDecoder(coders.config));
+        coders.viterbiDecoder->setMaxTailBitingIterations(_maxTailBitingIterations);
+
+        const auto* inBuff = static_cast<const std::int8_t*>(input);
+        auto* outBuff = static_cast<std::uint8_t*>(output);
+
+        if(packed) coders.viterbiDecoder->decodePacked(inBuff, outBuff);
+        else       coders.viterbiDecoder->decode(inBuff, outBuff);
+
+        this->_addTailBitingStats(coders.viterbiDecoder->takeTailBitingStats());
+    }
+    else
+    {
+        if(!coders.maxLogMAPDecoder) coders.maxLogMAPDecoder.reset(new MaxLogMAPConvDecoder(coders.config));
+
+        const auto* inBuff = static_cast<const std::int8_t*>(input);
+
+        if(_isFloatOutput) coders.maxLogMAPDecoder->decode(inBuff, 1, static_cast<float*>(output));
+        else               coders.maxLogMAPDecoder->decode(inBuff, 1, static_cast<std::int8_t*>(output));
+    }
 }
@@ -3,6 +3,13 @@
 
 #pragma once
 
+#include "ConvCodeConfig.hpp"
+#include "ConvEncoder.hpp"
+#include "ConvolutionUtility.hpp"
+#include "MaxLogMAPConvDecoder.hpp"
+#include "MultiFrameViterbiDecoder.hpp"
+#include "ViterbiDecoder.hpp"
+
 #include <Pothos/Framework.hpp>
 
 #include <Poco/Mutex.h>
@@ -12,13 +19,20 @@ extern "C"
 #include <turbofec/conv.h>
 }
 
+#include <atomic>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 class ConvolutionBase: public Pothos::Block
 {
 public:
-    ConvolutionBase(lte_conv_code* pConvCode, bool isEncoder);
+    ConvolutionBase(
+        const lte_conv_code& convCode,
+        size_t genArrLength,
+        bool isEncoder,
+        const Pothos::DType& outputDType = Pothos::DType("uint8"));
 
     virtual ~ConvolutionBase();
 
@@ -38,28 +52,125 @@ public:
 
     std::string terminationType() const;
 
+    int encodedLength() const;
+
+    size_t maxFramesPerWork() const;
+
+    void setMaxFramesPerWork(size_t maxFramesPerWork);
+
+    bool packed() const;
+
+    void setPacked(bool packed);
+
+    std::string blockStartID() const;
+
+    void setBlockStartID(const std::string& blockStartID);
+
+    size_t maxTailBitingIterations() const;
+
+    void setMaxTailBitingIterations(size_t maxTailBitingIterations);
+
+    // How often a tail-biting frame's decoded path started and ended in
+    // the same state, and how many passes each frame took, since the last
+    // activation. Both are 0 before any frames are decoded.
+    double stateMatchRate() const;
+
+    double averageIterations() const;
+
+    void propagateLabels(const Pothos::InputPort* input) override;
+
     void work() override;
 
 protected:
-    lte_conv_code* _pConvCode;
-    size_t _genArrLength;
     bool _isEncoder;
 
-    mutable Poco::FastMutex _convCodeMutex;
+    // Soft decoders output int8 or float32 LLRs rather than hard bits.
+    bool _isSoftDecoder;
+    bool _isFloatOutput;
+    std::atomic<size_t> _maxFramesPerWork;
+
+    // Whether the uncoded bits, the encoder's input or the decoder's output,
+    // are packed MSB-first into bytes.
+    std::atomic<bool> _packed;
+
+
+    // Only used by hard decoders, for tail-biting codes.
+    std::atomic<size_t> _maxTailBitingIterations;
+    std::atomic<size_t> _numTailBitingFrames;
+    std::atomic<size_t> _numTailBitingStateMatches;
+    std::atomic<size_t> _numTailBitingIterations;
+
+    // Only used by encoders, and only from work(). Like the decoders below,
+    // this is rebuilt when a new snapshot is published.
+    ConvEncoder::UPtr _convEncoder;
+
+    // Only used by decoders, and only from work(). This is rebuilt when a
+    // new snapshot is published, so steady-state decoding never allocates.
+    ViterbiDecoder::UPtr _viterbiDecoder;
+
+    // Used in place of the above when enough frames are queued to fill
+    // every lane.
+    MultiFrameViterbiDecoder::UPtr _multiFrameViterbiDecoder;
+
+    // Used in place of the above by soft decoders.
+    MaxLogMAPConvDecoder::UPtr _maxLogMAPDecoder;
+
+    // The coders for label-delimited frames of a given length, created
+    // on first use.
+    struct BlockCoders
+    {
+        ConvCodeConfig::SPtr config;
+        ConvEncoder::UPtr convEncoder;
+        ViterbiDecoder::UPtr viterbiDecoder;
+        MaxLogMAPConvDecoder::UPtr maxLogMAPDecoder;
+    };
+
+    // Keyed by frame length, for the snapshot they were derived from. Like
+    // the coders above, these are only used from work().
+    ConvCodeConfig::SPtr _blockCodersSource;
+    std::map<int, BlockCoders> _blockCoders;
+
+    // Serializes subclass setters. Readers never take this, as they
+    // only load the current snapshot.
+    Poco::FastMutex _convCodeMutex;
+
+    ConvCodeConfig::SPtr _getConvCodeConfig() const;
+
+    std::shared_ptr<const std::string> _getBlockStartID() const;
+
+    // Validates and publishes the given code. If this throws, the
+    // current snapshot is left unchanged.
+    void _setConvCodeConfig(const lte_conv_code& convCode, size_t genArrLength);
+
+    void _updatePortReserves(const ConvCodeConfig& config);
+
+    size_t _numFramesToProcess(size_t inputFrameSize, size_t outputFrameSize) const;
+
+    void _encoderWork(const ConvCodeConfig::SPtr& config);
+
+    void _blockIDWork(const ConvCodeConfig::SPtr& config, const std::string& blockStartID);
+
+    int _getBlockLength(const ConvCodeConfig& config, const Pothos::Label& label) const;
 
-    int _expectedEncodeSize;
-    std::vector<std::uint8_t> _expectedEncodeCalcInputVec;
-    std::vector<std::uint8_t> _expectedEncodeCalcOutputVec;
+    BlockCoders& _getBlockCoders(const ConvCodeConfig::SPtr& config, int length);
 
-    std::vector<unsigned> _gen() const;
+    void _codeBlock(BlockCoders& coders, const void* input, void* output, bool packed);
 
-    std::vector<int> _punctureFunc() const;
+    void _decoderWork(const ConvCodeConfig::SPtr& config);
 
-    std::string _terminationType() const;
+    void _addTailBitingStats(const TailBitingStats& stats);
 
-    void _updatePortReserves();
+    template <typename T>
+    void _softDecoderWork(const ConvCodeConfig::SPtr& config);
 
-    void _encoderWork();
+private:
+    // Only access through std::atomic_load and std::atomic_store.
+    ConvCodeConfig::SPtr _convCodeConfig;
 
-    void _decoderWork();
+    // If not empty, frames start at labels with this ID, whose data gives
+    // each frame's length, instead of following each other back-to-back at
+    // the configured length. A string can't be atomic like the settings
+    // above, so this is a snapshot like the code, with the same access
+    // rules.
+    std::shared_ptr<const std::string> _blockStartID;
 };
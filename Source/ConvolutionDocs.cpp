@@ -1,8 +1,8 @@
 //
-// Copyright (c) 2020-2020 Nicholas Corgan
+// Copyright (c) 2020-2026 Nicholas Corgan
 // SPDX-License-Identifier: GPL-3.0-or-later
 //
-// This file was generated on 2020-06-26 17:04:44.152085.
+// This file was generated on 2026-10-18 05:24:27.205241.
 //
 
 /*
@@ -15,6 +15,32 @@
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_xcch_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_xcch();
 
@@ -28,6 +54,32 @@ void gsm_xcch();
  * |category /FEC/GPRS
  * |keywords coder lte
  * |factory /fec/gprs_cs2_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gprs_cs2();
 
@@ -41,6 +93,32 @@ void gprs_cs2();
  * |category /FEC/GPRS
  * |keywords coder lte
  * |factory /fec/gprs_cs3_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gprs_cs3();
 
@@ -54,6 +132,32 @@ void gprs_cs3();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_rach_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_rach();
 
@@ -67,6 +171,32 @@ void gsm_rach();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_sch_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_sch();
 
@@ -80,6 +210,32 @@ void gsm_sch();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_fr_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_fr();
 
@@ -93,6 +249,32 @@ void gsm_tch_fr();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_hr_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_hr();
 
@@ -106,6 +288,32 @@ void gsm_tch_hr();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs12_2_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs12_2();
 
@@ -119,6 +327,32 @@ void gsm_tch_afs12_2();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs10_2_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs10_2();
 
@@ -132,6 +366,32 @@ void gsm_tch_afs10_2();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs7_95_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs7_95();
 
@@ -145,6 +405,32 @@ void gsm_tch_afs7_95();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs7_4_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs7_4();
 
@@ -158,6 +444,32 @@ void gsm_tch_afs7_4();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs6_7_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs6_7();
 
@@ -171,6 +483,32 @@ void gsm_tch_afs6_7();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs5_9_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs5_9();
 
@@ -184,6 +522,32 @@ void gsm_tch_afs5_9();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs7_95_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs7_95();
 
@@ -197,6 +561,32 @@ void gsm_tch_ahs7_95();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs7_4_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs7_4();
 
@@ -210,6 +600,32 @@ void gsm_tch_ahs7_4();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs6_7_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs6_7();
 
@@ -223,6 +639,32 @@ void gsm_tch_ahs6_7();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs5_9_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs5_9();
 
@@ -236,6 +678,32 @@ void gsm_tch_ahs5_9();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs5_15_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs5_15();
 
@@ -249,6 +717,32 @@ void gsm_tch_ahs5_15();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs4_75_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs4_75();
 
@@ -262,6 +756,32 @@ void gsm_tch_ahs4_75();
  * |category /FEC/WiMax
  * |keywords coder lte
  * |factory /fec/wimax_fch_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void wimax_fch();
 
@@ -275,6 +795,32 @@ void wimax_fch();
  * |category /FEC/LTE
  * |keywords coder lte
  * |factory /fec/lte_pbch_encoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void lte_pbch();
 
@@ -289,6 +835,32 @@ void lte_pbch();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_xcch_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_xcch();
 
@@ -302,6 +874,32 @@ void gsm_xcch();
  * |category /FEC/GPRS
  * |keywords coder lte
  * |factory /fec/gprs_cs2_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gprs_cs2();
 
@@ -315,6 +913,32 @@ void gprs_cs2();
  * |category /FEC/GPRS
  * |keywords coder lte
  * |factory /fec/gprs_cs3_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gprs_cs3();
 
@@ -328,6 +952,32 @@ void gprs_cs3();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_rach_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_rach();
 
@@ -341,6 +991,32 @@ void gsm_rach();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_sch_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_sch();
 
@@ -354,6 +1030,32 @@ void gsm_sch();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_fr_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_fr();
 
@@ -367,6 +1069,32 @@ void gsm_tch_fr();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_hr_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_hr();
 
@@ -380,6 +1108,32 @@ void gsm_tch_hr();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs12_2_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs12_2();
 
@@ -393,6 +1147,32 @@ void gsm_tch_afs12_2();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs10_2_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs10_2();
 
@@ -406,6 +1186,32 @@ void gsm_tch_afs10_2();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs7_95_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs7_95();
 
@@ -419,6 +1225,32 @@ void gsm_tch_afs7_95();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs7_4_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs7_4();
 
@@ -432,6 +1264,32 @@ void gsm_tch_afs7_4();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs6_7_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs6_7();
 
@@ -445,6 +1303,32 @@ void gsm_tch_afs6_7();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_afs5_9_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_afs5_9();
 
@@ -458,6 +1342,32 @@ void gsm_tch_afs5_9();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs7_95_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs7_95();
 
@@ -471,6 +1381,32 @@ void gsm_tch_ahs7_95();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs7_4_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs7_4();
 
@@ -484,6 +1420,32 @@ void gsm_tch_ahs7_4();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs6_7_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs6_7();
 
@@ -497,6 +1459,32 @@ void gsm_tch_ahs6_7();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs5_9_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs5_9();
 
@@ -510,6 +1498,32 @@ void gsm_tch_ahs5_9();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs5_15_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs5_15();
 
@@ -523,6 +1537,32 @@ void gsm_tch_ahs5_15();
  * |category /FEC/GSM
  * |keywords coder lte
  * |factory /fec/gsm_tch_ahs4_75_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void gsm_tch_ahs4_75();
 
@@ -536,6 +1576,41 @@ void gsm_tch_ahs4_75();
  * |category /FEC/WiMax
  * |keywords coder lte
  * |factory /fec/wimax_fch_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ * |setter setMaxTailBitingIterations(maxTailBitingIterations)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ *
+ * |param maxTailBitingIterations[Max Tail-Biting Iterations]
+ * Tail-biting frames are decoded with repeated passes over the frame, each starting
+ * from where the last one ended, until the decoded path starts and ends in the same
+ * state or this many passes are made.
+ * |widget SpinBox(minimum=1)
+ * |default 4
+ * |preview disable
  */
 void wimax_fch();
 
@@ -549,5 +1624,839 @@ void wimax_fch();
  * |category /FEC/LTE
  * |keywords coder lte
  * |factory /fec/lte_pbch_decoder()
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ * |setter setMaxTailBitingIterations(maxTailBitingIterations)
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ *
+ * |param maxTailBitingIterations[Max Tail-Biting Iterations]
+ * Tail-biting frames are decoded with repeated passes over the frame, each starting
+ * from where the last one ended, until the decoded path starts and ends in the same
+ * state or this many passes are made.
+ * |widget SpinBox(minimum=1)
+ * |default 4
+ * |preview disable
+ */
+void lte_pbch();
+
+
+/*
+ * |PothosDoc GSM XCCH Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM XCCH data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_xcch_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_xcch();
+
+/*
+ * |PothosDoc GPRS CS2 Soft Decoder
+ *
+ * Takes in soft bits of encoded GPRS CS2 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GPRS
+ * |keywords coder lte soft llr
+ * |factory /fec/gprs_cs2_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gprs_cs2();
+
+/*
+ * |PothosDoc GPRS CS3 Soft Decoder
+ *
+ * Takes in soft bits of encoded GPRS CS3 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GPRS
+ * |keywords coder lte soft llr
+ * |factory /fec/gprs_cs3_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gprs_cs3();
+
+/*
+ * |PothosDoc GSM RACH Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM RACH data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_rach_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_rach();
+
+/*
+ * |PothosDoc GSM SCH Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM SCH data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_sch_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_sch();
+
+/*
+ * |PothosDoc GSM TCH-FR Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-FR data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_fr_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_fr();
+
+/*
+ * |PothosDoc GSM TCH-HR Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-HR data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_hr_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_hr();
+
+/*
+ * |PothosDoc GSM TCH-AFS12.2 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AFS12.2 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_afs12_2_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_afs12_2();
+
+/*
+ * |PothosDoc GSM TCH-AFS10.2 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AFS10.2 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_afs10_2_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_afs10_2();
+
+/*
+ * |PothosDoc GSM TCH-AFS7.95 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AFS7.95 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_afs7_95_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_afs7_95();
+
+/*
+ * |PothosDoc GSM TCH-AFS7.4 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AFS7.4 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_afs7_4_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_afs7_4();
+
+/*
+ * |PothosDoc GSM TCH-AFS6.7 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AFS6.7 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_afs6_7_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_afs6_7();
+
+/*
+ * |PothosDoc GSM TCH-AFS5.9 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AFS5.9 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_afs5_9_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_afs5_9();
+
+/*
+ * |PothosDoc GSM TCH-AHS7.95 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AHS7.95 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_ahs7_95_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_ahs7_95();
+
+/*
+ * |PothosDoc GSM TCH-AHS7.4 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AHS7.4 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_ahs7_4_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_ahs7_4();
+
+/*
+ * |PothosDoc GSM TCH-AHS6.7 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AHS6.7 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_ahs6_7_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_ahs6_7();
+
+/*
+ * |PothosDoc GSM TCH-AHS5.9 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AHS5.9 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_ahs5_9_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_ahs5_9();
+
+/*
+ * |PothosDoc GSM TCH-AHS5.15 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AHS5.15 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_ahs5_15_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_ahs5_15();
+
+/*
+ * |PothosDoc GSM TCH-AHS4.75 Soft Decoder
+ *
+ * Takes in soft bits of encoded GSM TCH-AHS4.75 data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/GSM
+ * |keywords coder lte soft llr
+ * |factory /fec/gsm_tch_ahs4_75_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void gsm_tch_ahs4_75();
+
+/*
+ * |PothosDoc WiMax FCH Soft Decoder
+ *
+ * Takes in soft bits of encoded WiMax FCH data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/WiMax
+ * |keywords coder lte soft llr
+ * |factory /fec/wimax_fch_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+void wimax_fch();
+
+/*
+ * |PothosDoc LTE PBCH Soft Decoder
+ *
+ * Takes in soft bits of encoded LTE PBCH data, where positive values correspond
+ * to 1, and outputs a log-likelihood ratio for each decoded bit, computed
+ * with the max-log approximation of the BCJR algorithm. The sign of each LLR
+ * is the bit a Viterbi decoder would output, and its magnitude is on the same
+ * scale as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/LTE
+ * |keywords coder lte soft llr
+ * |factory /fec/lte_pbch_soft_decoder(dtype)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 void lte_pbch();
@@ -0,0 +1,138 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ConvolutionUtility.hpp"
+
+#include <Pothos/Exception.hpp>
+
+#include <limits>
+
+void validateConvCode(const lte_conv_code& convCode)
+{
+    if((convCode.n < 2) || (convCode.n > 4))
+    {
+        throw Pothos::InvalidArgumentException("N must be in range [2,4]");
+    }
+    if((convCode.k < 3) || (convCode.k > 9))
+    {
+        throw Pothos::InvalidArgumentException("K must be in range [3,9]");
+    }
+    if(convCode.len < 1)
+    {
+        throw Pothos::InvalidArgumentException("Length must be positive");
+    }
+    if((::CONV_TERM_TAIL_BITING == convCode.term) && (convCode.rgen > 0))
+    {
+        throw Pothos::InvalidArgumentException("Tail-biting codes cannot be recursive");
+    }
+    if(calcConvEncodedLength(convCode) < 1)
+    {
+        throw Pothos::InvalidArgumentException("Puncturing removes all output bits");
+    }
+}
+
+int calcConvUnpuncturedLength(const lte_conv_code& convCode, int length)
+{
+    // Flushing appends K-1 tail bits to return the encoder to the zero state.
+    // Tail-biting starts in the end state, so no extra bits are needed.
+    int numInputBits = length;
+    if(::CONV_TERM_FLUSH == convCode.term) numInputBits += (convCode.k - 1);
+
+    return (convCode.n * numInputBits);
+}
+
+// TurboFEC walks the -1-terminated puncture list in order as it generates
+// output, so only the ascending run of positions within the unpunctured
+// output are removed.
+template <typename Fcn>
+static void forEachPuncturedPosition(
+    const lte_conv_code& convCode,
+    int unpuncturedLength,
+    Fcn fcn)
+{
+    if(!convCode.punc) return;
+
+    int prevPos = -1;
+    for(const int* pPunc = convCode.punc; (*pPunc != -1); ++pPunc)
+    {
+        if((*pPunc <= prevPos) || (*pPunc >= unpuncturedLength)) break;
+
+        prevPos = *pPunc;
+        fcn(*pPunc);
+    }
+}
+
+int calcConvEncodedLength(const lte_conv_code& convCode, int length)
+{
+    const int unpuncturedLength = calcConvUnpuncturedLength(convCode, length);
+
+    int numPunctured = 0;
+    forEachPuncturedPosition(
+        convCode,
+        unpuncturedLength,
+        [&numPunctured](int)
+        {
+            ++numPunctured;
+        });
+
+    return (unpuncturedLength - numPunctured);
+}
+
+int calcConvDataLength(const lte_conv_code& convCode, int encodedLength)
+{
+    if(encodedLength < 1) return -1;
+
+    // Each input bit adds N unpunctured output bits, and puncturing can
+    // remove at most all of them, so the encoded length never decreases
+    // with the block length. Find the shortest block at least this long.
+    int low = 1;
+    int high = 1;
+    while(calcConvEncodedLength(convCode, high) < encodedLength)
+    {
+        low = high + 1;
+        if(high > (std::numeric_limits<int>::max() / (4 * convCode.n))) return -1;
+        high *= 2;
+    }
+
+    while(low < high)
+    {
+        const int mid = low + ((high - low) / 2);
+
+        if(calcConvEncodedLength(convCode, mid) < encodedLength) low = mid + 1;
+        else                                                      high = mid;
+    }
+
+    return (calcConvEncodedLength(convCode, low) == encodedLength) ? low : -1;
+}
+
+std::vector<std::uint8_t> getConvPunctureMask(const lte_conv_code& convCode, int length)
+{
+    const int unpuncturedLength = calcConvUnpuncturedLength(convCode, length);
+
+    std::vector<std::uint8_t> mask(static_cast<size_t>(unpuncturedLength), 1);
+    forEachPuncturedPosition(
+        convCode,
+        unpuncturedLength,
+        [&mask](int pos)
+        {
+            mask[static_cast<size_t>(pos)] = 0;
+        });
+
+    return mask;
+}
+
+std::vector<int> getConvDepunctureMap(const lte_conv_code& convCode, int length)
+{
+    const auto punctureMask = getConvPunctureMask(convCode, length);
+
+    std::vector<int> depunctureMap;
+    depunctureMap.reserve(punctureMask.size());
+
+    int encodedIndex = 0;
+    for(auto keep: punctureMask)
+    {
+        depunctureMap.emplace_back(keep ? (encodedIndex++) : -1);
+    }
+
+    return depunctureMap;
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+extern "C"
+{
+#include <turbofec/conv.h>
+}
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Throws Pothos::InvalidArgumentException if the in-tree coders cannot
+// code with the given parameters.
+void validateConvCode(const lte_conv_code& convCode);
+
+// Returns the number of bits the encoder outputs for a block of the
+// given length before puncturing.
+int calcConvUnpuncturedLength(const lte_conv_code& convCode, int length);
+
+// Returns the number of bits lte_conv_encode outputs for a block of the
+// given length, accounting for termination and puncturing.
+int calcConvEncodedLength(const lte_conv_code& convCode, int length);
+
+static inline int calcConvEncodedLength(const lte_conv_code& convCode)
+{
+    return calcConvEncodedLength(convCode, convCode.len);
+}
+
+// Returns the block length whose encoded length is the given one, or -1 if
+// no block length encodes to exactly that many bits.
+int calcConvDataLength(const lte_conv_code& convCode, int encodedLength);
+
+// Returns whether each bit of the unpunctured output for a block of the
+// given length is kept (1) or punctured (0).
+std::vector<std::uint8_t> getConvPunctureMask(const lte_conv_code& convCode, int length);
+
+// Returns, for each bit of the unpunctured output for a block of the given
+// length, the index of the corresponding encoded bit, or -1 if punctured.
+std::vector<int> getConvDepunctureMap(const lte_conv_code& convCode, int length);
+
+// Tail-biting frames are decoded with wrap-around Viterbi passes, each
+// starting from the last one's final path metrics, until the best path
+// starts and ends in the same state or this many passes have been made.
+static constexpr size_t DefaultMaxTailBitingIterations = 4;
+
+// Running totals over the tail-biting frames a Viterbi decoder has decoded,
+// for reporting how quickly its passes converge.
+struct TailBitingStats
+{
+    size_t numFrames;
+    size_t numStateMatches;
+    size_t numIterations;
+};
+
+// Identifies a code's constraint length and rate. The coders instantiate
+// their kernels with both fixed at compile time for the shapes of the
+// standard codes, so the loops over states and outputs fully unroll, and
+// fall back to kernels that read them at runtime for any other code.
+static constexpr int convCodeShape(int K, int N)
+{
+    return (K << 4) | N;
+}
+
+// Decoders make at most two passes over a frame's symbols, the second only
+// for tail-biting frames, so this maps a step to its symbols without the
+// division a modulo would cost on every step.
+static inline size_t getSymbolStep(size_t step, size_t numSymbolSteps)
+{
+    return (step < numSymbolSteps) ? step : (step - numSymbolSteps);
+}
+
+// Reads a bit to encode either from its own byte or MSB-first from
+// packed bytes.
+template <bool Packed>
+static inline unsigned readInputBit(const std::uint8_t* input, size_t index)
+{
+    return Packed ? ((input[index / 8] >> (7 - (index % 8))) & 1U) : (input[index] & 1U);
+}
+
+// Writes decoded bits from the last to the first, the order a traceback
+// produces them in, either each as its own byte or MSB-first into packed
+// bytes. Packed bits are gathered into a whole byte, which is stored once
+// bit 0 of it is written, so every bit down to 0 must be written.
+template <bool Packed>
+class TracebackBitWriter
+{
+public:
+    explicit TracebackBitWriter(std::uint8_t* output):
+        _output(output),
+        _byte(0)
+    {}
+
+    inline void write(size_t index, unsigned bit)
+    {
+        if(!Packed)
+        {
+            _output[index] = static_cast<std::uint8_t>(bit);
+            return;
+        }
+
+        _byte |= bit << (7 - (index % 8));
+        if(0 == (index % 8))
+        {
+            _output[index / 8] = static_cast<std::uint8_t>(_byte);
+            _byte = 0;
+        }
+    }
+
+private:
+    std::uint8_t* _output;
+    unsigned _byte;
+};
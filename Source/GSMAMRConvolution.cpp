@@ -0,0 +1,479 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ConvCodeConfig.hpp"
+#include "ConvEncoder.hpp"
+#include "MultiFrameViterbiDecoder.hpp"
+#include "ViterbiDecoder.hpp"
+
+extern "C"
+{
+    #include "ConvCodes.h"
+};
+
+#include <Pothos/Callable.hpp>
+#include <Pothos/Exception.hpp>
+#include <Pothos/Framework.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+// AMR codec modes, numbered as in 3GPP TS 26.071.
+static constexpr unsigned NumAMRModes = 8;
+
+// 7.95, the highest rate mode both channels support
+static constexpr unsigned DefaultAMRMode = 5;
+
+struct AMRModeCode
+{
+    unsigned mode;
+    const lte_conv_code* convCode;
+    size_t genArrLength;
+};
+
+// TCH-AFS4.75 and TCH-AFS5.15 are rate 1/5 codes, which TurboFEC and the
+// in-tree coders don't support, so full-rate channels can't use those modes.
+static const std::vector<AMRModeCode> AFSModeCodes =
+{
+    {2, get_gsm_conv_tch_afs_5_9(), 4},
+    {3, get_gsm_conv_tch_afs_6_7(), 4},
+    {4, get_gsm_conv_tch_afs_7_4(), 3},
+    {5, get_gsm_conv_tch_afs_7_95(), 3},
+    {6, get_gsm_conv_tch_afs_10_2(), 3},
+    {7, get_gsm_conv_tch_afs_12_2(), 2},
+};
+
+static const std::vector<AMRModeCode> AHSModeCodes =
+{
+    {0, get_gsm_conv_tch_ahs_4_75(), 3},
+    {1, get_gsm_conv_tch_ahs_5_15(), 3},
+    {2, get_gsm_conv_tch_ahs_5_9(), 2},
+    {3, get_gsm_conv_tch_ahs_6_7(), 2},
+    {4, get_gsm_conv_tch_ahs_7_4(), 2},
+    {5, get_gsm_conv_tch_ahs_7_95(), 2},
+};
+
+static const std::vector<AMRModeCode>& getChannelModeCodes(const std::string& channel)
+{
+    if("AFS" == channel)      return AFSModeCodes;
+    else if("AHS" == channel) return AHSModeCodes;
+
+    throw Pothos::InvalidArgumentException("Invalid channel: "+channel);
+}
+
+// Codes frames of whichever AMR codec mode is current, switching modes at
+// labels whose data is the new mode. The coders for every mode supported
+// by the channel are built on construction, so switching only changes
+// which one the next frame uses.
+//
+// Frames follow each other back-to-back, except that a mode label always
+// starts a new frame, and any partial frame before it is dropped. Each
+// output frame whose mode differs from the previous output frame's is
+// labeled the same way, so a decoder can follow an encoder's mode changes.
+class GSMAMRConvolution: public Pothos::Block
+{
+public:
+    static Pothos::Block* make(const std::string& channel, bool isEncoder)
+    {
+        return new GSMAMRConvolution(channel, isEncoder);
+    }
+
+    GSMAMRConvolution(const std::string& channel, bool isEncoder):
+        Pothos::Block(),
+        _channel(channel),
+        _isEncoder(isEncoder),
+        _modeCoders(NumAMRModes),
+        _mode(DefaultAMRMode),
+        _modeLabelID("AMR_MODE"),
+        _lastOutputMode(NumAMRModes)
+    {
+        const auto& modeCodes = getChannelModeCodes(channel);
+        for(const auto& modeCode: modeCodes)
+        {
+            auto& coders = _modeCoders[modeCode.mode];
+            coders.config = ConvCodeConfig::make(*modeCode.convCode, modeCode.genArrLength);
+
+            if(_isEncoder) coders.convEncoder.reset(new ConvEncoder(coders.config));
+            else           coders.viterbiDecoder.reset(new ViterbiDecoder(coders.config));
+        }
+
+        this->setupInput(0, (_isEncoder ? "uint8" : "int8"));
+        this->setupOutput(0, "uint8");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(GSMAMRConvolution, channel));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GSMAMRConvolution, modes));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GSMAMRConvolution, mode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GSMAMRConvolution, setMode));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GSMAMRConvolution, length));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GSMAMRConvolution, encodedLength));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GSMAMRConvolution, modeLabelID));
+        this->registerCall(this, POTHOS_FCN_TUPLE(GSMAMRConvolution, setModeLabelID));
+
+        this->registerProbe("mode");
+        this->registerProbe("modeLabelID");
+
+        this->registerSignal("modeChanged");
+        this->registerSignal("modeLabelIDChanged");
+    }
+
+    std::string channel() const
+    {
+        return _channel;
+    }
+
+    std::vector<unsigned> modes() const
+    {
+        std::vector<unsigned> modes;
+        for(unsigned mode = 0; mode < NumAMRModes; ++mode)
+        {
+            if(_modeCoders[mode].config) modes.emplace_back(mode);
+        }
+
+        return modes;
+    }
+
+    unsigned mode() const
+    {
+        return _mode;
+    }
+
+    // Sets the mode for the frames after the ones already coded, until a
+    // mode label changes it.
+    void setMode(unsigned mode)
+    {
+        this->_validateMode(mode);
+        _mode = mode;
+
+        this->emitSignal("modeChanged", mode);
+    }
+
+    int length(unsigned mode) const
+    {
+        this->_validateMode(mode);
+
+        return _modeCoders[mode].config->convCode().len;
+    }
+
+    int encodedLength(unsigned mode) const
+    {
+        this->_validateMode(mode);
+
+        return _modeCoders[mode].config->encodedLength();
+    }
+
+    std::string modeLabelID() const
+    {
+        return _modeLabelID;
+    }
+
+    void setModeLabelID(const std::string& modeLabelID)
+    {
+        if(modeLabelID.empty())
+        {
+            throw Pothos::InvalidArgumentException("The mode label ID cannot be empty");
+        }
+
+        _modeLabelID = modeLabelID;
+
+        this->emitSignal("modeLabelIDChanged", modeLabelID);
+    }
+
+    void activate() override
+    {
+        _lastOutputMode = NumAMRModes;
+        this->_updatePortReserves(_mode);
+    }
+
+    void propagateLabels(const Pothos::InputPort* input) override
+    {
+        // We post our own mode labels when the output frames' mode changes.
+        for(const auto& label: input->labels())
+        {
+            if(label.id != _modeLabelID) this->output(0)->postLabel(label);
+        }
+    }
+
+    void work() override
+    {
+        auto input = this->input(0);
+        auto output = this->output(0);
+
+        const auto numInputElems = input->elements();
+        const auto numOutputElems = output->elements();
+
+        const auto* inBuff = input->buffer().as<const std::uint8_t*>();
+        auto* outBuff = output->buffer().as<std::uint8_t*>();
+
+        // The labels in the buffer that change modes, in order
+        std::vector<Pothos::Label> modeLabels;
+        for(const auto& label: input->labels())
+        {
+            if((label.id == _modeLabelID) && (label.index < numInputElems)) modeLabels.emplace_back(label);
+        }
+
+        unsigned mode = _mode;
+        size_t labelIndex = 0;
+        size_t inputIndex = 0;
+        size_t outputIndex = 0;
+
+        while(true)
+        {
+            // Switch modes for any labels at or before the start of this frame.
+            for(; (labelIndex < modeLabels.size()) && (modeLabels[labelIndex].index <= inputIndex); ++labelIndex)
+            {
+                mode = this->_getLabelMode(modeLabels[labelIndex]);
+            }
+
+            auto& coders = _modeCoders[mode];
+            const auto length = static_cast<size_t>(coders.config->convCode().len);
+            const auto encodedLength = static_cast<size_t>(coders.config->encodedLength());
+            const auto inputFrameSize = _isEncoder ? length : encodedLength;
+            const auto outputFrameSize = _isEncoder ? encodedLength : length;
+
+            // Frames that follow each other back-to-back can be decoded in
+            // parallel, up to the next mode label.
+            size_t inputEnd = numInputElems;
+            if(labelIndex < modeLabels.size())
+            {
+                const auto nextLabelIndex = static_cast<size_t>(modeLabels[labelIndex].index);
+
+                // A mode label inside this frame starts a new frame.
+                if(nextLabelIndex < (inputIndex + inputFrameSize))
+                {
+                    inputIndex = nextLabelIndex;
+                    continue;
+                }
+
+                inputEnd = nextLabelIndex;
+            }
+
+            const auto numFrames = std::min(
+                                       (inputEnd - inputIndex) / inputFrameSize,
+                                       (numOutputElems - outputIndex) / outputFrameSize);
+            if(0 == numFrames) break;
+
+            if(mode != _lastOutputMode)
+            {
+                output->postLabel(_modeLabelID, mode, outputIndex);
+                _lastOutputMode = mode;
+            }
+
+            if(_isEncoder)
+            {
+                for(size_t frame = 0; frame < numFrames; ++frame)
+                {
+                    coders.convEncoder->encode(
+                        inBuff + inputIndex + (frame * inputFrameSize),
+                        outBuff + outputIndex + (frame * outputFrameSize));
+                }
+            }
+            else this->_decode(coders, numFrames, inBuff + inputIndex, outBuff + outputIndex);
+
+            inputIndex += (numFrames * inputFrameSize);
+            outputIndex += (numFrames * outputFrameSize);
+        }
+
+        // Any mode labels up to here have been applied, and the mode of the
+        // frame we stopped at takes effect the next time we're called.
+        _mode = mode;
+
+        input->consume(inputIndex);
+        if(outputIndex > 0) output->produce(outputIndex);
+
+        this->_updatePortReserves(mode);
+    }
+
+private:
+    struct ModeCoders
+    {
+        ConvCodeConfig::SPtr config;
+        ConvEncoder::UPtr convEncoder;
+        ViterbiDecoder::UPtr viterbiDecoder;
+
+        // Only created once enough frames of this mode are queued to fill
+        // every lane.
+        MultiFrameViterbiDecoder::UPtr multiFrameViterbiDecoder;
+    };
+
+    std::string _channel;
+    bool _isEncoder;
+
+    // Indexed by mode, with no coders for modes the channel doesn't support
+    std::vector<ModeCoders> _modeCoders;
+
+    std::atomic<unsigned> _mode;
+    std::string _modeLabelID;
+
+    // Only used from work(). NumAMRModes until we output a frame.
+    unsigned _lastOutputMode;
+
+    void _validateMode(unsigned mode) const
+    {
+        if((mode >= NumAMRModes) || !_modeCoders[mode].config)
+        {
+            throw Pothos::InvalidArgumentException(
+                      "Unsupported mode for TCH-"+_channel,
+                      std::to_string(mode));
+        }
+    }
+
+    unsigned _getLabelMode(const Pothos::Label& label) const
+    {
+        const auto mode = label.data.convert<unsigned>();
+        this->_validateMode(mode);
+
+        return mode;
+    }
+
+    void _updatePortReserves(unsigned mode)
+    {
+        const auto& config = *_modeCoders[mode].config;
+        const auto length = static_cast<size_t>(config.convCode().len);
+        const auto encodedLength = static_cast<size_t>(config.encodedLength());
+
+        this->input(0)->setReserve(_isEncoder ? length : encodedLength);
+        this->output(0)->setReserve(_isEncoder ? encodedLength : length);
+    }
+
+    void _decode(
+        ModeCoders& coders,
+        size_t numFrames,
+        const std::uint8_t* input,
+        std::uint8_t* output)
+    {
+        const auto* inBuff = reinterpret_cast<const std::int8_t*>(input);
+        const auto inputFrameSize = static_cast<size_t>(coders.config->encodedLength());
+        const auto outputFrameSize = static_cast<size_t>(coders.config->convCode().len);
+
+        constexpr size_t numLanes = MultiFrameViterbiDecoder::NumLanes;
+        size_t frame = 0;
+
+        if(numFrames >= numLanes)
+        {
+            if(!coders.multiFrameViterbiDecoder)
+            {
+                coders.multiFrameViterbiDecoder.reset(new MultiFrameViterbiDecoder(coders.config));
+            }
+
+            for(; (frame + numLanes) <= numFrames; frame += numLanes)
+            {
+                coders.multiFrameViterbiDecoder->decode(
+                    inBuff + (frame * inputFrameSize),
+                    output + (frame * outputFrameSize));
+            }
+        }
+
+        for(; frame < numFrames; ++frame)
+        {
+            coders.viterbiDecoder->decode(
+                inBuff + (frame * inputFrameSize),
+                output + (frame * outputFrameSize));
+        }
+    }
+};
+
+//
+// Registrations
+//
+
+/*
+ * |PothosDoc GSM AMR Encoder
+ *
+ * Encodes frames of GSM adaptive multi-rate speech, switching between the codec
+ * modes' convolutional codes frame by frame. The mode changes at labels whose data
+ * is the new mode, which always start a new frame, and stays the same until the
+ * next such label. The codes for every mode are built when the block is created,
+ * so switching modes costs nothing.
+ *
+ * Each output frame whose mode differs from the previous one starts with the same
+ * label, so a GSM AMR decoder can follow the mode changes.
+ *
+ * |category /FEC/GSM
+ * |keywords coder amr speech tch
+ * |factory /fec/gsm_amr_encoder(channel)
+ * |setter setMode(mode)
+ * |setter setModeLabelID(modeLabelID)
+ *
+ * |param channel[Channel] Full-rate (TCH-AFS) or half-rate (TCH-AHS) speech.
+ * TCH-AFS doesn't support the 4.75 and 5.15 modes.
+ * |widget ComboBox(editable=false)
+ * |option [TCH-AFS] "AFS"
+ * |option [TCH-AHS] "AHS"
+ * |default "AFS"
+ * |preview enable
+ *
+ * |param mode[Mode] The initial codec mode, numbered as in 3GPP TS 26.071.
+ * |widget ComboBox(editable=false)
+ * |option [4.75] 0
+ * |option [5.15] 1
+ * |option [5.9] 2
+ * |option [6.7] 3
+ * |option [7.4] 4
+ * |option [7.95] 5
+ * |option [10.2] 6
+ * |option [12.2] 7
+ * |default 5
+ * |preview enable
+ *
+ * |param modeLabelID[Mode Label ID]
+ * The ID of labels whose data is the mode of the frames starting there.
+ * |widget LineEdit()
+ * |default "AMR_MODE"
+ * |preview disable
+ */
+static Pothos::BlockRegistry registerGSMAMREncoder(
+    "/fec/gsm_amr_encoder",
+    Pothos::Callable(&GSMAMRConvolution::make)
+        .bind(true, 1));
+
+/*
+ * |PothosDoc GSM AMR Decoder
+ *
+ * Decodes frames of GSM adaptive multi-rate speech, switching between the codec
+ * modes' convolutional codes frame by frame. The mode changes at labels whose data
+ * is the new mode, which always start a new frame, and stays the same until the
+ * next such label. The codes for every mode are built when the block is created,
+ * so switching modes costs nothing.
+ *
+ * Each output frame whose mode differs from the previous one starts with the same
+ * label.
+ *
+ * |category /FEC/GSM
+ * |keywords coder amr speech tch
+ * |factory /fec/gsm_amr_decoder(channel)
+ * |setter setMode(mode)
+ * |setter setModeLabelID(modeLabelID)
+ *
+ * |param channel[Channel] Full-rate (TCH-AFS) or half-rate (TCH-AHS) speech.
+ * TCH-AFS doesn't support the 4.75 and 5.15 modes.
+ * |widget ComboBox(editable=false)
+ * |option [TCH-AFS] "AFS"
+ * |option [TCH-AHS] "AHS"
+ * |default "AFS"
+ * |preview enable
+ *
+ * |param mode[Mode] The initial codec mode, numbered as in 3GPP TS 26.071.
+ * |widget ComboBox(editable=false)
+ * |option [4.75] 0
+ * |option [5.15] 1
+ * |option [5.9] 2
+ * |option [6.7] 3
+ * |option [7.4] 4
+ * |option [7.95] 5
+ * |option [10.2] 6
+ * |option [12.2] 7
+ * |default 5
+ * |preview enable
+ *
+ * |param modeLabelID[Mode Label ID]
+ * The ID of labels whose data is the mode of the frames starting there.
+ * |widget LineEdit()
+ * |default "AMR_MODE"
+ * |preview disable
+ */
+static Pothos::BlockRegistry registerGSMAMRDecoder(
+    "/fec/gsm_amr_decoder",
+    Pothos::Callable(&GSMAMRConvolution::make)
+        .bind(false, 1));
@@ -18,20 +18,44 @@ static bool isVectorEmptyOrZeros(const std::vector<unsigned>& vec)
     return (nonZeroIter == vec.end());
 }
 
+// Note: defaults come from GSM XCCH.
+static lte_conv_code getDefaultConvCode()
+{
+    lte_conv_code convCode;
+    std::memset(&convCode, 0, sizeof(convCode));
+
+    convCode.n = 2;
+    convCode.k = 5;
+    convCode.len = 224;
+    convCode.rgen = 0;
+    convCode.gen[0] = 023;
+    convCode.gen[1] = 033;
+    convCode.punc = nullptr;
+    convCode.term = ::CONV_TERM_FLUSH;
+
+    return convCode;
+}
+static constexpr size_t DefaultGenArrLength = 2;
+
+// Each setter copies the current snapshot's code, modifies the copy,
+// and publishes it as a new snapshot. If the new code is invalid, the
+// current snapshot is left untouched, so there's nothing to roll back.
 class GenericConvolution: public ConvolutionBase
 {
 public:
     static Pothos::Block* make(bool isEncoder)
     {
-        return new GenericConvolution(isEncoder);
+        return new GenericConvolution(isEncoder, "uint8");
     }
 
-    GenericConvolution(bool isEncoder):
-        ConvolutionBase(nullptr, isEncoder)
+    static Pothos::Block* makeSoftDecoder(const Pothos::DType& dtype)
     {
-        std::memset(&_convCode, 0, sizeof(_convCode));
-        _pConvCode = &_convCode;
+        return new GenericConvolution(false, dtype);
+    }
 
+    GenericConvolution(bool isEncoder, const Pothos::DType& outputDType):
+        ConvolutionBase(getDefaultConvCode(), DefaultGenArrLength, isEncoder, outputDType)
+    {
         this->registerCall(this, POTHOS_FCN_TUPLE(GenericConvolution, setN));
         this->registerCall(this, POTHOS_FCN_TUPLE(GenericConvolution, setK));
         this->registerCall(this, POTHOS_FCN_TUPLE(GenericConvolution, setLength));
@@ -47,39 +71,25 @@ public:
         this->registerSignal("genChanged");
         this->registerSignal("punctureChanged");
         this->registerSignal("terminationTypeChanged");
-
-        // Note: defaults come from GSM XCCH.
-        this->_setN(2);
-        this->_setK(5);
-        this->_setLength(224);
-        this->_setRGen(0);
-        this->_setGen({023, 033});
-        this->_setPuncture({});
-        this->_setTerminationType("Flush");
     }
 
     ~GenericConvolution() {}
 
     void setN(int n)
     {
-        Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
         if((n < 2) || (n > 4))
         {
             throw Pothos::InvalidArgumentException("N must be in range [2,4]");
         }
 
-        int oldN = 0;
-        try
-        {
-            this->_setN(n, &oldN);
-            this->_updatePortReserves();
-        }
-        catch(const Pothos::Exception& ex)
         {
-            this->_setN(oldN);
-            this->_updatePortReserves();
-            throw;
+            Poco::FastMutex::ScopedLock lock(_convCodeMutex);
+
+            const auto config = this->_getConvCodeConfig();
+            auto convCode = config->convCode();
+            convCode.n = n;
+
+            this->_setConvCodeConfig(convCode, config->genArrLength());
         }
 
         this->emitSignal("NChanged", n);
@@ -87,24 +97,19 @@ public:
 
     void setK(int k)
     {
-        Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
-        if((k != 5) && (k != 7))
+        if((k < 3) || (k > 9))
         {
-            throw Pothos::InvalidArgumentException("K must be 5 or 7");
+            throw Pothos::InvalidArgumentException("K must be in range [3,9]");
         }
 
-        int oldK = 0;
-        try
-        {
-            this->_setK(k, &oldK);
-            this->_updatePortReserves();
-        }
-        catch(const Pothos::Exception& ex)
         {
-            this->_setK(oldK);
-            this->_updatePortReserves();
-            throw;
+            Poco::FastMutex::ScopedLock lock(_convCodeMutex);
+
+            const auto config = this->_getConvCodeConfig();
+            auto convCode = config->convCode();
+            convCode.k = k;
+
+            this->_setConvCodeConfig(convCode, config->genArrLength());
         }
 
         this->emitSignal("KChanged", k);
@@ -112,24 +117,19 @@ public:
 
     void setLength(int length)
     {
-        Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
         if(length < 1)
         {
             throw Pothos::InvalidArgumentException("Length must be positive");
         }
 
-        int oldLength = 0;
-        try
-        {
-            this->_setLength(length, &oldLength);
-            this->_updatePortReserves();
-        }
-        catch(const Pothos::Exception& ex)
         {
-            this->_setLength(oldLength);
-            this->_updatePortReserves();
-            throw;
+            Poco::FastMutex::ScopedLock lock(_convCodeMutex);
+
+            const auto config = this->_getConvCodeConfig();
+            auto convCode = config->convCode();
+            convCode.len = length;
+
+            this->_setConvCodeConfig(convCode, config->genArrLength());
         }
 
         this->emitSignal("lengthChanged", length);
@@ -137,35 +137,31 @@ public:
 
     void setRGen(unsigned rgen)
     {
-        Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
-        if(rgen > 0)
         {
-            if(::CONV_TERM_TAIL_BITING == _pConvCode->term)
+            Poco::FastMutex::ScopedLock lock(_convCodeMutex);
+
+            const auto config = this->_getConvCodeConfig();
+            auto convCode = config->convCode();
+
+            if(rgen > 0)
             {
-                throw Pothos::InvalidArgumentException(
-                          "Cannot set RGen to a positive value "
-                          "when termination is set to Tail-biting.");
+                if(::CONV_TERM_TAIL_BITING == convCode.term)
+                {
+                    throw Pothos::InvalidArgumentException(
+                              "Cannot set RGen to a positive value "
+                              "when termination is set to Tail-biting.");
+                }
+                else if(isVectorEmptyOrZeros(config->gen()))
+                {
+                    throw Pothos::InvalidArgumentException(
+                              "Cannot set RGen to a positive value "
+                              "when gen is empty or zero-only.");
+                }
             }
-            else if(isVectorEmptyOrZeros(this->_gen()))
-            {
-                throw Pothos::InvalidArgumentException(
-                          "Cannot set RGen to a positive value "
-                          "when gen is empty or zero-only.");
-            }
-        }
 
-        unsigned oldRGen = 0;
-        try
-        {
-            this->_setRGen(rgen, &oldRGen);
-            this->_updatePortReserves();
-        }
-        catch(const Pothos::Exception& ex)
-        {
-            this->_setRGen(oldRGen);
-            this->_updatePortReserves();
-            throw;
+            convCode.rgen = rgen;
+
+            this->_setConvCodeConfig(convCode, config->genArrLength());
         }
 
         this->emitSignal("rgenChanged", rgen);
@@ -173,30 +169,35 @@ public:
 
     void setGen(const std::vector<unsigned>& gen)
     {
-        Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
         if(gen.size() > 4)
         {
             throw Pothos::InvalidArgumentException("Gen must be of size 0-4");
         }
-        else if(isVectorEmptyOrZeros(gen) && (_pConvCode->rgen > 0))
-        {
-            throw Pothos::InvalidArgumentException(
-                      "Cannot set gen to an empty or all-zeros "
-                      "value when RGen is positive.");
-        }
 
-        std::vector<unsigned> oldGen;
-        try
-        {
-            this->_setGen(gen, &oldGen);
-            this->_updatePortReserves();
-        }
-        catch(const Pothos::Exception& ex)
         {
-            this->_setGen(oldGen);
-            this->_updatePortReserves();
-            throw;
+            Poco::FastMutex::ScopedLock lock(_convCodeMutex);
+
+            const auto config = this->_getConvCodeConfig();
+            auto convCode = config->convCode();
+
+            if(isVectorEmptyOrZeros(gen) && (convCode.rgen > 0))
+            {
+                throw Pothos::InvalidArgumentException(
+                          "Cannot set gen to an empty or all-zeros "
+                          "value when RGen is positive.");
+            }
+
+            // This is stored as a static array of size 4.
+            std::memset(convCode.gen, 0, sizeof(convCode.gen));
+            if(!gen.empty())
+            {
+                std::memcpy(
+                    convCode.gen,
+                    gen.data(),
+                    (gen.size() * sizeof(unsigned)));
+            }
+
+            this->_setConvCodeConfig(convCode, gen.size());
         }
 
         this->emitSignal("genChanged", gen);
@@ -204,8 +205,6 @@ public:
 
     void setPuncture(const std::vector<int>& puncture)
     {
-        Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
         // All puncture values must be positive. TurboFEC expects puncture
         // arrays to be terminated with -1, but we handle that ourselves.
         auto negativePuncIter = std::find_if(
@@ -220,134 +219,52 @@ public:
             throw Pothos::InvalidArgumentException("All puncture values must be >= 0.");
         }
 
-        std::vector<int> oldPuncture;
-        try
         {
-            this->_setPuncture(puncture, &oldPuncture);
-            this->_updatePortReserves();
-        }
-        catch(const Pothos::Exception& ex)
-        {
-            this->_setPuncture(oldPuncture);
-            this->_updatePortReserves();
-            throw;
-        }
+            Poco::FastMutex::ScopedLock lock(_convCodeMutex);
 
-        this->emitSignal("punctureChanged", puncture);
-    }
+            const auto config = this->_getConvCodeConfig();
+            auto convCode = config->convCode();
 
-    void setTerminationType(const std::string& terminationType)
-    {
-        Poco::FastMutex::ScopedLock lock(_convCodeMutex);
-
-        if(("Tail-biting" == terminationType) && (_pConvCode->rgen > 0))
-        {
-            throw Pothos::InvalidArgumentException(
-                      "Cannot set termination to Tail-biting"
-                      "when RGen is positive.");
-        }
+            // The new snapshot copies this, so it only needs to outlive
+            // the call below.
+            std::vector<int> terminatedPuncture(puncture);
+            if(puncture.empty())
+            {
+                convCode.punc = nullptr;
+            }
+            else
+            {
+                terminatedPuncture.emplace_back(-1);
+                convCode.punc = terminatedPuncture.data();
+            }
 
-        std::string oldTerminationType;
-        try
-        {
-            this->_setTerminationType(terminationType, &oldTerminationType);
-            this->_updatePortReserves();
+            this->_setConvCodeConfig(convCode, config->genArrLength());
         }
-        catch(const Pothos::Exception& ex)
-        {
-            this->_setTerminationType(oldTerminationType);
-            this->_updatePortReserves();
-            throw;
-        }
-
-        this->emitSignal("terminationTypeChanged", terminationType);
-    }
-
-private:
-    lte_conv_code _convCode; // For base class to point to
-    std::vector<int> _puncture; // For _convCode's pointer to point to
 
-    inline void _setN(int N, int* oldNOut = nullptr)
-    {
-        if(oldNOut) *oldNOut = _pConvCode->n;
-        _pConvCode->n = N;
-    }
-
-    inline void _setK(int K, int* oldKOut = nullptr)
-    {
-        if(oldKOut) *oldKOut = _pConvCode->k;
-        _pConvCode->k = K;
-    }
-
-    inline void _setLength(int length, int* oldLengthOut = nullptr)
-    {
-        if(oldLengthOut) *oldLengthOut = _pConvCode->len;
-        _pConvCode->len = length;
-    }
-
-    inline void _setRGen(unsigned rgen, unsigned* oldRGenOut = nullptr)
-    {
-        if(oldRGenOut) *oldRGenOut = _pConvCode->rgen;
-        _pConvCode->rgen = rgen;
+        this->emitSignal("punctureChanged", puncture);
     }
 
-    void _setGen(
-        const std::vector<unsigned>& gen,
-        std::vector<unsigned>* oldGenOut = nullptr)
+    void setTerminationType(const std::string& terminationType)
     {
-        if(oldGenOut) *oldGenOut = this->_gen();
-
-        // This is stored as a static array of size 4.
-        std::memset(_pConvCode->gen, 0, sizeof(_pConvCode->gen));
-        if(!gen.empty())
         {
-            std::memcpy(
-                _pConvCode->gen,
-                gen.data(),
-                (gen.size() * sizeof(unsigned)));
-        }
+            Poco::FastMutex::ScopedLock lock(_convCodeMutex);
 
-        _genArrLength = gen.size();
-    }
+            const auto config = this->_getConvCodeConfig();
+            auto convCode = config->convCode();
 
-    void _setPuncture(
-        const std::vector<int>& puncture,
-        std::vector<int>* oldPunctureOut = nullptr)
-    {
-        if(oldPunctureOut) *oldPunctureOut = this->_punctureFunc();
+            if(("Tail-biting" == terminationType) && (convCode.rgen > 0))
+            {
+                throw Pothos::InvalidArgumentException(
+                          "Cannot set termination to Tail-biting "
+                          "when RGen is positive.");
+            }
 
-        _puncture = puncture;
+            convCode.term = terminationTypeFromString(terminationType);
 
-        if(puncture.empty())
-        {
-            _pConvCode->punc = nullptr;
+            this->_setConvCodeConfig(convCode, config->genArrLength());
         }
-        else
-        {
-            // TurboFEC expects puncture arrays to be terminated with -1.
-            _puncture.emplace_back(-1);
-            _pConvCode->punc = _puncture.data();
-        }
-    }
 
-    void _setTerminationType(
-        const std::string& terminationType,
-        std::string* oldTerminationTypeOut = nullptr)
-    {
-        if(oldTerminationTypeOut) *oldTerminationTypeOut = this->_terminationType();
-
-        if("Flush" == terminationType)
-        {
-            _pConvCode->term = ::CONV_TERM_FLUSH;
-        }
-        else if("Tail-biting" == terminationType)
-        {
-            _pConvCode->term = ::CONV_TERM_TAIL_BITING;
-        }
-        else
-        {
-            throw Pothos::InvalidArgumentException("Invalid termination type: "+terminationType);
-        }
+        this->emitSignal("terminationTypeChanged", terminationType);
     }
 };
 
@@ -364,16 +281,17 @@ private:
  * |setter setGen(gen)
  * |setter setPuncture(puncture)
  * |setter setTerminationType(terminationType)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
  *
  * |param N[Rate] 2, 3, 4 (corresponding to 1/2, 1/3, 1/4)
  * |widget SpinBox(minimum=2,maximum=4)
  * |default 2
  * |preview enable
  *
- * |param K[Constraint Length] 5 or 7
- * |widget ComboBox(editable=False)
- * |option 5
- * |option 7
+ * |param K[Constraint Length] 3 through 9
+ * |widget SpinBox(minimum=3,maximum=9)
  * |default 5
  * |preview enable
  *
@@ -403,6 +321,29 @@ private:
  * |option [Tail-biting] "Tail-biting"
  * |default "Flush"
  * |preview enable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the input bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's length in bits, rather than frames of the configured length following each
+ * other back-to-back. Each encoded frame starts with the same label, whose data gives
+ * its encoded length. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
  */
 static Pothos::BlockRegistry registerGenericConvolutionEncoder(
     "/fec/generic_conv_encoder",
@@ -422,16 +363,18 @@ static Pothos::BlockRegistry registerGenericConvolutionEncoder(
  * |setter setGen(gen)
  * |setter setPuncture(puncture)
  * |setter setTerminationType(terminationType)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setPacked(packed)
+ * |setter setBlockStartID(blockStartID)
+ * |setter setMaxTailBitingIterations(maxTailBitingIterations)
  *
  * |param N[Rate] 2, 3, 4 (corresponding to 1/2, 1/3, 1/4)
  * |widget SpinBox(minimum=2,maximum=4)
  * |default 2
  * |preview enable
  *
- * |param K[Constraint Length] 5 or 7
- * |widget ComboBox(editable=False)
- * |option 5
- * |option 7
+ * |param K[Constraint Length] 3 through 9
+ * |widget SpinBox(minimum=3,maximum=9)
  * |default 5
  * |preview enable
  *
@@ -461,8 +404,123 @@ static Pothos::BlockRegistry registerGenericConvolutionEncoder(
  * |option [Tail-biting] "Tail-biting"
  * |default "Flush"
  * |preview enable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param packed[Packed?]
+ * When set to true, the output bits are packed MSB-first into bytes, with each frame
+ * starting on a byte boundary. When set to false, each byte holds a single bit.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ *
+ * |param maxTailBitingIterations[Max Tail-Biting Iterations]
+ * Tail-biting frames are decoded with repeated passes over the frame, each starting
+ * from where the last one ended, until the decoded path starts and ends in the same
+ * state or this many passes are made. Unused by flushed codes.
+ * |widget SpinBox(minimum=1)
+ * |default 4
+ * |preview disable
  */
 static Pothos::BlockRegistry registerGenericConvolutionDecoder(
     "/fec/generic_conv_decoder",
     Pothos::Callable(&GenericConvolution::make)
         .bind(false, 0));
+
+/*
+ * |PothosDoc Generic Convolution Soft Decoder
+ *
+ * Takes in soft bits, where positive values correspond to 1, and outputs
+ * a log-likelihood ratio for each decoded bit, computed with the max-log
+ * approximation of the BCJR algorithm. The sign of each LLR is the bit a
+ * Viterbi decoder would output, and its magnitude is on the same scale
+ * as the input soft bits. int8 outputs saturate at +/-127.
+ *
+ * |category /FEC/Convolution
+ * |keywords N K gen recursive termination gsm lte soft llr
+ * |factory /fec/generic_conv_soft_decoder(dtype)
+ * |setter setN(N)
+ * |setter setK(K)
+ * |setter setLength(length)
+ * |setter setRGen(rgen)
+ * |setter setGen(gen)
+ * |setter setPuncture(puncture)
+ * |setter setTerminationType(terminationType)
+ * |setter setMaxFramesPerWork(maxFramesPerWork)
+ * |setter setBlockStartID(blockStartID)
+ *
+ * |param dtype[Data Type] The LLR output type
+ * |widget DTypeChooser(int8=1,float32=1)
+ * |default "float32"
+ * |preview disable
+ *
+ * |param N[Rate] 2, 3, 4 (corresponding to 1/2, 1/3, 1/4)
+ * |widget SpinBox(minimum=2,maximum=4)
+ * |default 2
+ * |preview enable
+ *
+ * |param K[Constraint Length] 3 through 9
+ * |widget SpinBox(minimum=3,maximum=9)
+ * |default 5
+ * |preview enable
+ *
+ * |param length[Length] Length of blocks to convolve
+ * |widget SpinBox(minimum=1)
+ * |default 224
+ * |preview enable
+ *
+ * |param rgen[RGen] Recursive generator polynomial
+ * |widget SpinBox(minimum=0,base=8)
+ * |default 0
+ * |preview enable
+ *
+ * |param gen[Gen] Generator polynomial (length 0-4)
+ * |widget LineEdit()
+ * |default [0o23,0o33]
+ * |preview enable
+ *
+ * |param puncture[Puncture] Note: all values must be positive.
+ * |widget LineEdit()
+ * |default []
+ * |preview enable
+ *
+ * |param terminationType[Termination Type]
+ * |widget ComboBox(editable=False)
+ * |option [Flush] "Flush"
+ * |option [Tail-biting] "Tail-biting"
+ * |default "Flush"
+ * |preview enable
+ *
+ * |param maxFramesPerWork[Max Frames Per Work]
+ * The maximum number of complete frames to process in a single call to work().
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview disable
+ *
+ * |param blockStartID[Block Start ID]
+ * If not empty, each frame starts at a label with this ID, whose data gives the
+ * frame's encoded length, rather than frames of the configured length following each
+ * other back-to-back. Each decoded frame starts with the same label, whose data gives
+ * its length in bits. Frames without a length use the configured length.
+ * No frame can be longer than 65536 bits before encoding.
+ * |widget LineEdit()
+ * |default ""
+ * |preview disable
+ */
+static Pothos::BlockRegistry registerGenericConvolutionSoftDecoder(
+    "/fec/generic_conv_soft_decoder",
+    Pothos::Callable(&GenericConvolution::makeSoftDecoder));
@@ -0,0 +1,305 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "LTETurboUtility.hpp"
+#include "VectorTypes.hpp"
+
+#include <Pothos/Exception.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Plugin.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+static constexpr size_t NumStreams = 3;
+
+// HARQ process numbers are 3 bits for FDD and 4 bits for TDD, which has up
+// to 15 processes.
+static constexpr size_t MaxNumHARQProcesses = 16;
+
+// The soft bits per stream of the largest transport block's code blocks,
+// each with its 4 tail bits
+static size_t getMaxHARQLength()
+{
+    static const auto segmentation = calcLTECodeBlockSegmentation(LTEMaxTransportBlockSize);
+
+    return segmentation.totalCodeBlockSize() + (segmentation.numCodeBlocks * 4);
+}
+
+// Adds the input soft bits into the buffer, saturating instead of wrapping
+// around.
+static void combineSoftBits(std::int8_t* buffer, const std::int8_t* input, size_t length)
+{
+    constexpr size_t NumLanes = sizeof(Int8x16);
+
+    size_t i = 0;
+    for(; (i + NumLanes) <= length; i += NumLanes)
+    {
+        Int8x16 bufferVec, inputVec;
+        std::memcpy(&bufferVec, buffer + i, NumLanes);
+        std::memcpy(&inputVec, input + i, NumLanes);
+
+        const Int8x16 sum = saturatingAdd(bufferVec, inputVec);
+        std::memcpy(buffer + i, &sum, NumLanes);
+    }
+    for(; i < length; ++i)
+    {
+        buffer[i] = static_cast<std::int8_t>(std::max<int>(-128, std::min<int>(127, int(buffer[i]) + int(input[i]))));
+    }
+}
+
+// The transmission a HARQ label describes
+struct HARQTransmission
+{
+    size_t process;
+    size_t rv;
+    size_t length;
+    bool newData;
+};
+
+static size_t getHARQLabelValue(const Pothos::ObjectKwargs& kwargs, const std::string& key)
+{
+    const auto iter = kwargs.find(key);
+    if(kwargs.end() == iter)
+    {
+        throw Pothos::InvalidArgumentException("The HARQ label is missing a value", key);
+    }
+
+    return iter->second.convert<size_t>();
+}
+
+static HARQTransmission getHARQTransmission(const Pothos::Label& label)
+{
+    if(!label.data.canConvert(typeid(Pothos::ObjectKwargs)))
+    {
+        throw Pothos::InvalidArgumentException("The HARQ label must hold a map of its process, rv, and length");
+    }
+
+    const auto kwargs = label.data.convert<Pothos::ObjectKwargs>();
+
+    HARQTransmission transmission{};
+    transmission.process = getHARQLabelValue(kwargs, "process");
+    transmission.rv = getHARQLabelValue(kwargs, "rv");
+    transmission.length = getHARQLabelValue(kwargs, "length");
+    if(transmission.rv > 3)
+    {
+        throw Pothos::InvalidArgumentException("The redundancy version must be in [0, 3]", std::to_string(transmission.rv));
+    }
+    if(transmission.process >= MaxNumHARQProcesses)
+    {
+        throw Pothos::InvalidArgumentException(
+                  "The HARQ process must be in [0, " + std::to_string(MaxNumHARQProcesses - 1) + "]",
+                  std::to_string(transmission.process));
+    }
+    if(0 == transmission.length)
+    {
+        throw Pothos::InvalidArgumentException("The HARQ label's length must be positive");
+    }
+    if(transmission.length > getMaxHARQLength())
+    {
+        throw Pothos::InvalidArgumentException(
+                  "Max HARQ length: " + std::to_string(getMaxHARQLength()),
+                  std::to_string(transmission.length));
+    }
+
+    // Without a new data indicator, it's a retransmission, since Chase
+    // combining resends redundancy version 0, and incremental redundancy
+    // can cycle back to it.
+    const auto newDataIter = kwargs.find("newData");
+    transmission.newData = (kwargs.end() != newDataIter) && newDataIter->second.convert<bool>();
+
+    return transmission;
+}
+
+class LTEHARQCombiner: public Pothos::Block
+{
+    public:
+        static Pothos::Block* make()
+        {
+            return new LTEHARQCombiner();
+        }
+
+        LTEHARQCombiner():
+            Pothos::Block(),
+            _harqID("HARQ")
+        {
+            // Like the LTE Turbo Decoder, these take in uint8_t* buffers for consistency
+            // with the encoder, but the soft bits are int8_t.
+            for(size_t port = 0; port < NumStreams; ++port)
+            {
+                this->setupInput(port, "uint8");
+                this->setupOutput(port, "uint8");
+            }
+
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTEHARQCombiner, harqID));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTEHARQCombiner, setHARQID));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTEHARQCombiner, numProcesses));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTEHARQCombiner, clearProcesses));
+
+            this->registerProbe("numProcesses");
+        }
+
+        void activate() override
+        {
+            this->clearProcesses();
+        }
+
+        std::string harqID() const
+        {
+            return _harqID;
+        }
+
+        void setHARQID(const std::string& harqID)
+        {
+            _harqID = harqID;
+        }
+
+        // The number of HARQ processes with soft buffers
+        size_t numProcesses() const
+        {
+            return _softBuffers.size();
+        }
+
+        void clearProcesses()
+        {
+            _softBuffers.clear();
+        }
+
+        void work() override
+        {
+            const auto elems = this->workInfo().minInElements;
+            if(0 == elems) return;
+
+            const auto& inputs = this->inputs();
+
+            // Input 0 is expected to have the HARQ labels.
+            const Pothos::Label* harqLabel = nullptr;
+            for(const auto& label: inputs[0]->labels())
+            {
+                if((label.id == _harqID) && (label.index < elems))
+                {
+                    harqLabel = &label;
+                    break;
+                }
+            }
+
+            // Anything outside of a labeled transmission passes through.
+            if(!harqLabel)                  this->_passThrough(elems);
+            else if(0 != harqLabel->index)  this->_passThrough(harqLabel->index);
+            else
+            {
+                const auto transmission = getHARQTransmission(*harqLabel);
+
+                // Wait until we have the whole transmission.
+                if(elems < transmission.length)
+                {
+                    for(auto* input: inputs) input->setReserve(transmission.length);
+                    return;
+                }
+
+                this->_combine(transmission);
+            }
+        }
+
+    private:
+        std::string _harqID;
+
+        // Each process's soft bits, one stream after the other
+        std::unordered_map<size_t, std::vector<std::int8_t>> _softBuffers;
+
+        void _passThrough(size_t maxLength)
+        {
+            const auto& inputs = this->inputs();
+            const auto& outputs = this->outputs();
+
+            const auto length = std::min(maxLength, this->workInfo().minOutElements);
+            if(0 == length) return;
+
+            for(size_t port = 0; port < NumStreams; ++port)
+            {
+                std::memcpy(outputs[port]->buffer().as<void*>(), inputs[port]->buffer().as<const void*>(), length);
+
+                inputs[port]->consume(length);
+                outputs[port]->produce(length);
+            }
+        }
+
+        // Adds the transmission's soft bits into its process's soft buffer,
+        // and outputs the combined soft bits in place of the transmission.
+        // Bits a redundancy version doesn't include are expected to be 0,
+        // so the same addition serves both Chase combining and incremental
+        // redundancy.
+        void _combine(const HARQTransmission& transmission)
+        {
+            const auto& inputs = this->inputs();
+            const auto& outputs = this->outputs();
+            const auto length = transmission.length;
+
+            // A new transport block, or one of a different size, starts over.
+            auto& softBuffer = _softBuffers[transmission.process];
+            if(transmission.newData || (softBuffer.size() != (length * NumStreams)))
+            {
+                softBuffer.assign(length * NumStreams, 0);
+            }
+
+            for(size_t port = 0; port < NumStreams; ++port)
+            {
+                auto* softBits = softBuffer.data() + (port * length);
+                combineSoftBits(softBits, inputs[port]->buffer().as<const std::int8_t*>(), length);
+
+                // A transmission can be larger than the output buffer.
+                auto output = outputs[port];
+                const bool mustPostBuffer = (length > output->elements());
+                auto outputBuffer = mustPostBuffer ? Pothos::BufferChunk("uint8", length) : output->buffer();
+                std::memcpy(outputBuffer.as<void*>(), softBits, length);
+
+                inputs[port]->consume(length);
+                inputs[port]->setReserve(0);
+
+                if(mustPostBuffer) output->postBuffer(std::move(outputBuffer));
+                else               output->produce(length);
+            }
+        }
+};
+
+/*
+ * |PothosDoc LTE HARQ Combiner
+ *
+ * Combines the soft bits of each HARQ retransmission with those of the
+ * transmissions before it, so an LTE Turbo Decoder downstream decodes all
+ * of them at once, which succeeds at a lower SNR and in fewer iterations
+ * than decoding the retransmission alone.
+ *
+ * The three inputs are an LTE Turbo Decoder's three int8 soft bit streams,
+ * after de-rate-matching, where positive values correspond to 1 and bits
+ * a transmission didn't include are 0. Each transmission starts with a
+ * HARQ label on input 0, whose data is a map holding its HARQ "process"
+ * ID in [0, 15], its redundancy version "rv", and its "length" in soft bits
+ * per stream, which is at most that of the largest LTE transport block's
+ * code blocks. The soft bits of each process are kept between transmissions,
+ * and added to each of its transmissions with saturation, which serves
+ * both Chase combining and incremental redundancy. The combined soft bits
+ * are output in place of the transmission's. A "newData" flag, the new
+ * data indicator, starts the process over with a new transport block.
+ * Without it, a transmission is combined with the process's earlier ones
+ * whatever its redundancy version, unless its length differs.
+ *
+ * Anything outside of a transmission passes through unchanged.
+ *
+ * |category /FEC/LTE
+ * |keywords harq chase incremental redundancy soft combining
+ * |factory /fec/lte_harq_combiner()
+ * |setter setHARQID(harqID)
+ *
+ * |param harqID[HARQ ID]
+ * The ID of the labels that start each transmission.
+ * |widget LineEdit()
+ * |default "HARQ"
+ * |preview enable
+ */
+static Pothos::BlockRegistry registerLTEHARQCombiner(
+    "/fec/lte_harq_combiner",
+    Pothos::Callable(&LTEHARQCombiner::make));
@@ -0,0 +1,534 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "LTERateMatching.hpp"
+#include "LTETurboUtility.hpp"
+#include "WorkerPool.hpp"
+
+#include <Pothos/Exception.hpp>
+#include <Pothos/Framework.hpp>
+#include <Pothos/Plugin.hpp>
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Only this many tables are cached at once, as each is sized by its code
+// block size. A transport block needs at most three.
+static constexpr size_t MaxCachedTables = 16;
+
+static constexpr size_t NumStreams = 3;
+
+// The rate matcher takes in the LTE Turbo Encoder's three streams of a
+// transport block's code blocks and outputs its rate-matched bits. The
+// dematcher does the opposite, from soft bits to the LTE Turbo Decoder's
+// three streams.
+class LTERateMatcher: public Pothos::Block
+{
+    public:
+        static Pothos::Block* make(bool isDematcher)
+        {
+            return new LTERateMatcher(isDematcher);
+        }
+
+        LTERateMatcher(bool isDematcher):
+            Pothos::Block(),
+            _isDematcher(isDematcher),
+            _blockStartID("START"),
+            _numOutputBits(1440),
+            _rv(0),
+            _modulationOrder(2),
+            _numLayers(1),
+            _softBufferSize(0)
+        {
+            // Like the LTE Turbo Decoder, the dematcher outputs uint8_t* buffers for
+            // consistency with the encoder, but the soft bits are int8_t.
+            if(_isDematcher)
+            {
+                this->setupInput(0, "int8");
+                for(size_t port = 0; port < NumStreams; ++port) this->setupOutput(port, "uint8");
+            }
+            else
+            {
+                for(size_t port = 0; port < NumStreams; ++port) this->setupInput(port, "uint8");
+                this->setupOutput(0, "uint8");
+            }
+
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, blockStartID));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, setBlockStartID));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, numOutputBits));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, setNumOutputBits));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, rv));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, setRV));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, modulationOrder));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, setModulationOrder));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, numLayers));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, setNumLayers));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, softBufferSize));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTERateMatcher, setSoftBufferSize));
+
+            this->registerProbe("numOutputBits");
+            this->registerProbe("rv");
+            this->registerProbe("modulationOrder");
+            this->registerProbe("numLayers");
+            this->registerProbe("softBufferSize");
+
+            this->registerSignal("numOutputBitsChanged");
+            this->registerSignal("rvChanged");
+            this->registerSignal("modulationOrderChanged");
+            this->registerSignal("numLayersChanged");
+            this->registerSignal("softBufferSizeChanged");
+        }
+
+        std::string blockStartID() const
+        {
+            return _blockStartID;
+        }
+
+        void setBlockStartID(const std::string& blockStartID)
+        {
+            if(blockStartID.empty())
+            {
+                throw Pothos::InvalidArgumentException("Rate matching requires a block start ID, whose label holds the transport block size");
+            }
+
+            _blockStartID = blockStartID;
+        }
+
+        size_t numOutputBits() const
+        {
+            return _numOutputBits;
+        }
+
+        void setNumOutputBits(size_t numOutputBits)
+        {
+            if(0 == numOutputBits)
+            {
+                throw Pothos::InvalidArgumentException("The number of output bits must be positive");
+            }
+
+            _numOutputBits = numOutputBits;
+
+            this->emitSignal("numOutputBitsChanged", _numOutputBits);
+        }
+
+        size_t rv() const
+        {
+            return _rv;
+        }
+
+        void setRV(size_t rv)
+        {
+            if(rv >= LTENumRedundancyVersions)
+            {
+                throw Pothos::InvalidArgumentException("The redundancy version must be in [0, 3]", std::to_string(rv));
+            }
+
+            _rv = rv;
+
+            this->emitSignal("rvChanged", _rv);
+        }
+
+        size_t modulationOrder() const
+        {
+            return _modulationOrder;
+        }
+
+        void setModulationOrder(size_t modulationOrder)
+        {
+            if((2 != modulationOrder) && (4 != modulationOrder) && (6 != modulationOrder) && (8 != modulationOrder))
+            {
+                throw Pothos::InvalidArgumentException("The modulation order must be 2, 4, 6, or 8", std::to_string(modulationOrder));
+            }
+
+            _modulationOrder = modulationOrder;
+
+            this->emitSignal("modulationOrderChanged", _modulationOrder);
+        }
+
+        size_t numLayers() const
+        {
+            return _numLayers;
+        }
+
+        void setNumLayers(size_t numLayers)
+        {
+            if((0 == numLayers) || (numLayers > 4))
+            {
+                throw Pothos::InvalidArgumentException("The number of layers must be in [1, 4]", std::to_string(numLayers));
+            }
+
+            _numLayers = numLayers;
+
+            this->emitSignal("numLayersChanged", _numLayers);
+        }
+
+        size_t softBufferSize() const
+        {
+            return _softBufferSize;
+        }
+
+        void setSoftBufferSize(size_t softBufferSize)
+        {
+            _softBufferSize = softBufferSize;
+
+            this->emitSignal("softBufferSizeChanged", _softBufferSize);
+        }
+
+        void propagateLabels(const Pothos::InputPort* input) override
+        {
+            // Don't propagate input label.
+            for(const auto& label: input->labels())
+            {
+                if(label.id != _blockStartID)
+                {
+                    for(auto* output: this->outputs()) output->postLabel(label);
+                }
+            }
+        }
+
+        void work() override
+        {
+            const auto elems = this->workInfo().minInElements;
+            if(0 == elems) return;
+
+            const auto& inputs = this->inputs();
+
+            // Input 0 is expected to have the block ID labels.
+            for(const auto& label: inputs[0]->labels())
+            {
+                // Skip if we haven't received enough data for this label.
+                if(label.index > elems) continue;
+
+                // Skip if this isn't a block start label.
+                if(label.id != _blockStartID) continue;
+
+                if(!label.data.canConvert(typeid(size_t)))
+                {
+                    throw Pothos::InvalidArgumentException("The block start label must hold the transport block size");
+                }
+
+                const auto segmentation = calcLTECodeBlockSegmentation(label.data.convert<size_t>());
+                const auto inputSize = _isDematcher ? _numOutputBits : this->_calcStreamLength(segmentation);
+
+                // Skip all data before the block starts.
+                if(0 != label.index)
+                {
+                    for(auto* input: inputs)
+                    {
+                        input->consume(label.index);
+                        input->setReserve(inputSize);
+                    }
+                    return;
+                }
+
+                // If our block starts at the beginning of our buffer, wait until we have
+                // enough data.
+                if(elems < inputSize)
+                {
+                    for(auto* input: inputs) input->setReserve(inputSize);
+                    return;
+                }
+
+                if(_isDematcher) this->_dematchTransportBlock(segmentation);
+                else             this->_matchTransportBlock(segmentation);
+
+                for(auto* input: inputs) input->consume(inputSize);
+
+                // The decoder needs the transport block size to segment it the
+                // same way.
+                this->output(0)->postLabel(_blockStartID, segmentation.transportBlockSize, 0);
+                return;
+            }
+
+            for(auto* input: inputs) input->consume(elems);
+        }
+
+    private:
+        bool _isDematcher;
+
+        std::string _blockStartID;
+
+        size_t _numOutputBits;
+        size_t _rv;
+        size_t _modulationOrder;
+        size_t _numLayers;
+        size_t _softBufferSize;
+
+        // Keyed by code block size, number of filler bits, and circular
+        // buffer size, and only used from work()
+        std::map<std::tuple<size_t, size_t, size_t>, LTERateMatchingTable> _tables;
+
+        // Each code block's rate-matched bits and its table
+        struct CodeBlockJob
+        {
+            size_t rateMatchedStart;
+            size_t rateMatchedSize;
+            const LTERateMatchingTable* table;
+        };
+
+        size_t _calcStreamLength(const LTECodeBlockSegmentation& segmentation) const
+        {
+            return segmentation.totalCodeBlockSize() + (segmentation.numCodeBlocks * 4);
+        }
+
+        std::vector<CodeBlockJob> _getCodeBlockJobs(const LTECodeBlockSegmentation& segmentation)
+        {
+            const auto numCodeBlocks = segmentation.numCodeBlocks;
+            const auto rateMatchedSizes = calcLTERateMatchedSizes(numCodeBlocks, _numOutputBits, _modulationOrder, _numLayers);
+
+            // Only clear between transport blocks, so none of their tables
+            // are cleared out from under them.
+            if(_tables.size() >= MaxCachedTables) _tables.clear();
+
+            std::vector<CodeBlockJob> jobs;
+            size_t rateMatchedStart = 0;
+            for(size_t codeBlock = 0; codeBlock < numCodeBlocks; ++codeBlock)
+            {
+                const auto blockSize = segmentation.codeBlockSize(codeBlock);
+                const auto numFillerBits = (0 == codeBlock) ? segmentation.numFillerBits : 0;
+                const auto circularBufferSize = calcLTECircularBufferSize(blockSize, numCodeBlocks, _softBufferSize);
+
+                const auto key = std::make_tuple(blockSize, numFillerBits, circularBufferSize);
+                auto iter = _tables.find(key);
+                if(_tables.end() == iter)
+                {
+                    iter = _tables.emplace(key, LTERateMatchingTable(blockSize, numFillerBits, circularBufferSize)).first;
+                }
+
+                jobs.emplace_back(CodeBlockJob{rateMatchedStart, rateMatchedSizes[codeBlock], &iter->second});
+                rateMatchedStart += rateMatchedSizes[codeBlock];
+            }
+
+            return jobs;
+        }
+
+        // The code blocks are independent, so they're rate matched in
+        // parallel, straight from the input streams.
+        void _matchTransportBlock(const LTECodeBlockSegmentation& segmentation)
+        {
+            const auto& inputs = this->inputs();
+            auto output = this->output(0);
+
+            const auto jobs = this->_getCodeBlockJobs(segmentation);
+
+            const bool mustPostBuffer = (_numOutputBits > output->elements());
+            auto outputBuffer = mustPostBuffer ? Pothos::BufferChunk("uint8", _numOutputBits) : output->buffer();
+            auto* outBuff = outputBuffer.as<std::uint8_t*>();
+
+            const std::uint8_t* inBuffs[] =
+            {
+                inputs[0]->buffer().as<const std::uint8_t*>(),
+                inputs[1]->buffer().as<const std::uint8_t*>(),
+                inputs[2]->buffer().as<const std::uint8_t*>()
+            };
+
+            WorkerPool::global().parallelFor(
+                jobs.size(),
+                [&](size_t codeBlock)
+                {
+                    const auto streamStart = segmentation.codeBlockStart(codeBlock) + (codeBlock * 4);
+                    const std::uint8_t* streams[] =
+                    {
+                        inBuffs[0] + streamStart,
+                        inBuffs[1] + streamStart,
+                        inBuffs[2] + streamStart
+                    };
+
+                    const auto& job = jobs[codeBlock];
+                    job.table->rateMatch(_rv, streams, job.rateMatchedSize, outBuff + job.rateMatchedStart);
+                });
+
+            if(mustPostBuffer) output->postBuffer(std::move(outputBuffer));
+            else               output->produce(_numOutputBits);
+        }
+
+        // The code blocks are independent, so they're dematched in parallel,
+        // straight into the decoder's layout of the output streams.
+        void _dematchTransportBlock(const LTECodeBlockSegmentation& segmentation)
+        {
+            const auto& outputs = this->outputs();
+            const auto* inBuff = this->input(0)->buffer().as<const std::int8_t*>();
+
+            const auto jobs = this->_getCodeBlockJobs(segmentation);
+            const auto streamLength = this->_calcStreamLength(segmentation);
+
+            std::vector<Pothos::BufferChunk> outputBuffers;
+            for(auto* output: outputs)
+            {
+                if(output->elements() >= streamLength) outputBuffers.emplace_back(output->buffer());
+                else                                   outputBuffers.emplace_back(Pothos::BufferChunk("uint8", streamLength));
+            }
+
+            std::int8_t* outBuffs[] =
+            {
+                outputBuffers[0].as<std::int8_t*>(),
+                outputBuffers[1].as<std::int8_t*>(),
+                outputBuffers[2].as<std::int8_t*>()
+            };
+
+            WorkerPool::global().parallelFor(
+                jobs.size(),
+                [&](size_t codeBlock)
+                {
+                    const auto streamStart = segmentation.codeBlockStart(codeBlock) + (codeBlock * 4);
+                    std::int8_t* streams[] =
+                    {
+                        outBuffs[0] + streamStart,
+                        outBuffs[1] + streamStart,
+                        outBuffs[2] + streamStart
+                    };
+
+                    const auto& job = jobs[codeBlock];
+                    job.table->rateDematch(_rv, inBuff + job.rateMatchedStart, job.rateMatchedSize, streams);
+                });
+
+            for(size_t port = 0; port < outputs.size(); ++port)
+            {
+                if(outputs[port]->elements() >= streamLength) outputs[port]->produce(streamLength);
+                else                                          outputs[port]->postBuffer(std::move(outputBuffers[port]));
+            }
+        }
+};
+
+/*
+ * |PothosDoc LTE Rate Matcher
+ *
+ * Rate matches each transport block from an LTE Turbo Encoder in transport block
+ * mode, as in TS 36.212 section 5.1.4.1. Each code block's three streams are
+ * sub-block interleaved and collected into its circular buffer, from which the
+ * code block's share of the output bits is selected, starting where the redundancy
+ * version does. The output holds every code block's selected bits back-to-back,
+ * and the block start label's data is the transport block size.
+ *
+ * The tables mapping each code block size's circular buffer to the encoder's
+ * streams are computed once and reused.
+ *
+ * |category /FEC/LTE
+ * |keywords coder rate matching puncture harq
+ * |factory /fec/lte_rate_matcher()
+ * |setter setBlockStartID(blockStartID)
+ * |setter setNumOutputBits(numOutputBits)
+ * |setter setRV(rv)
+ * |setter setModulationOrder(modulationOrder)
+ * |setter setNumLayers(numLayers)
+ * |setter setSoftBufferSize(softBufferSize)
+ *
+ * |param blockStartID[Block Start ID]
+ * The label that starts each transport block, whose data holds the transport block size,
+ * of up to 391656 bits.
+ * |widget LineEdit()
+ * |default "START"
+ * |preview disable
+ *
+ * |param numOutputBits[Num Output Bits]
+ * The number of bits each transport block is rate matched to, G.
+ * |widget SpinBox(minimum=2)
+ * |default 1440
+ * |preview enable
+ *
+ * |param rv[Redundancy Version]
+ * |widget SpinBox(minimum=0,maximum=3)
+ * |default 0
+ * |preview enable
+ *
+ * |param modulationOrder[Modulation Order]
+ * The number of bits per modulation symbol. Each code block gets a whole number of
+ * symbols on every layer.
+ * |widget ComboBox(editable=false)
+ * |option [QPSK] 2
+ * |option [16QAM] 4
+ * |option [64QAM] 6
+ * |option [256QAM] 8
+ * |default 2
+ * |preview disable
+ *
+ * |param numLayers[Num Layers]
+ * The number of layers the transport block is mapped to, or 2 for transmit diversity.
+ * |widget SpinBox(minimum=1,maximum=4)
+ * |default 1
+ * |preview disable
+ *
+ * |param softBufferSize[Soft Buffer Size]
+ * The receiver's soft buffer size for the transport block, N_IR, which limits
+ * each code block's circular buffer. 0 means it's unlimited, as for the uplink.
+ * |widget SpinBox(minimum=0)
+ * |default 0
+ * |preview disable
+ */
+static Pothos::BlockRegistry registerLTERateMatcher(
+    "/fec/lte_rate_matcher",
+    Pothos::Callable(&LTERateMatcher::make)
+        .bind(false, 0));
+
+/*
+ * |PothosDoc LTE Rate Dematcher
+ *
+ * The inverse of the LTE Rate Matcher, which takes in each transport block's
+ * rate-matched soft bits, where positive values correspond to 1, and writes each
+ * code block's soft bits straight into the three streams an LTE Turbo Decoder in
+ * transport block mode takes in. Bits that weren't transmitted are 0, repeated
+ * bits are added together, and filler bits are output as a certain 0. The block
+ * start label's data is the transport block size.
+ *
+ * To combine retransmissions with an LTE HARQ Combiner, place it between this
+ * block and the decoder.
+ *
+ * |category /FEC/LTE
+ * |keywords coder rate matching puncture harq
+ * |factory /fec/lte_rate_dematcher()
+ * |setter setBlockStartID(blockStartID)
+ * |setter setNumOutputBits(numOutputBits)
+ * |setter setRV(rv)
+ * |setter setModulationOrder(modulationOrder)
+ * |setter setNumLayers(numLayers)
+ * |setter setSoftBufferSize(softBufferSize)
+ *
+ * |param blockStartID[Block Start ID]
+ * The label that starts each transport block, whose data holds the transport block size,
+ * of up to 391656 bits.
+ * |widget LineEdit()
+ * |default "START"
+ * |preview disable
+ *
+ * |param numOutputBits[Num Output Bits]
+ * The number of bits each transport block was rate matched to, G, which is the
+ * number of soft bits each transport block takes in.
+ * |widget SpinBox(minimum=2)
+ * |default 1440
+ * |preview enable
+ *
+ * |param rv[Redundancy Version]
+ * |widget SpinBox(minimum=0,maximum=3)
+ * |default 0
+ * |preview enable
+ *
+ * |param modulationOrder[Modulation Order]
+ * The number of bits per modulation symbol. Each code block gets a whole number of
+ * symbols on every layer.
+ * |widget ComboBox(editable=false)
+ * |option [QPSK] 2
+ * |option [16QAM] 4
+ * |option [64QAM] 6
+ * |option [256QAM] 8
+ * |default 2
+ * |preview disable
+ *
+ * |param numLayers[Num Layers]
+ * The number of layers the transport block is mapped to, or 2 for transmit diversity.
+ * |widget SpinBox(minimum=1,maximum=4)
+ * |default 1
+ * |preview disable
+ *
+ * |param softBufferSize[Soft Buffer Size]
+ * The receiver's soft buffer size for the transport block, N_IR, which limits
+ * each code block's circular buffer. 0 means it's unlimited, as for the uplink.
+ * |widget SpinBox(minimum=0)
+ * |default 0
+ * |preview disable
+ */
+static Pothos::BlockRegistry registerLTERateDematcher(
+    "/fec/lte_rate_dematcher",
+    Pothos::Callable(&LTERateMatcher::make)
+        .bind(true, 0));
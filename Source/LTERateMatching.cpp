@@ -0,0 +1,213 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "LTERateMatching.hpp"
+#include "LTETurboUtility.hpp"
+
+#include <Pothos/Exception.hpp>
+
+#include <algorithm>
+#include <string>
+
+static constexpr size_t NumStreams = 3;
+
+// The sub-block interleaver's columns, and the order they're read in
+static constexpr size_t NumColumns = 32;
+static const size_t ColumnPermutation[NumColumns] =
+{
+    0, 16, 8, 24, 4, 20, 12, 28, 2, 18, 10, 26, 6, 22, 14, 30,
+    1, 17, 9, 25, 5, 21, 13, 29, 3, 19, 11, 27, 7, 23, 15, 31
+};
+
+// Marks the dummy and filler bits, which aren't in the circular buffer
+static constexpr std::uint16_t NullBit = 0xFFFF;
+
+static size_t getNumRows(size_t blockSize)
+{
+    return ((blockSize + 4) + (NumColumns - 1)) / NumColumns;
+}
+
+size_t calcLTECircularBufferSize(
+    size_t blockSize,
+    size_t numCodeBlocks,
+    size_t softBufferSize)
+{
+    const size_t fullSize = NumStreams * NumColumns * getNumRows(blockSize);
+    const size_t circularBufferSize = (0 == softBufferSize) ? fullSize : std::min(fullSize, softBufferSize / numCodeBlocks);
+    if(0 == circularBufferSize)
+    {
+        throw Pothos::InvalidArgumentException(
+                  "The soft buffer is too small for the number of code blocks",
+                  std::to_string(softBufferSize));
+    }
+
+    return circularBufferSize;
+}
+
+std::vector<size_t> calcLTERateMatchedSizes(
+    size_t numCodeBlocks,
+    size_t numOutputBits,
+    size_t modulationOrder,
+    size_t numLayers)
+{
+    const size_t symbolSize = modulationOrder * numLayers;
+    if((0 == symbolSize) || (0 != (numOutputBits % symbolSize)))
+    {
+        throw Pothos::InvalidArgumentException(
+                  "The number of output bits must be a multiple of the modulation order times the number of layers",
+                  std::to_string(numOutputBits));
+    }
+
+    // The last code blocks take any remainder, a symbol each.
+    const size_t numSymbols = numOutputBits / symbolSize;
+    const size_t numLargerBlocks = numSymbols % numCodeBlocks;
+
+    std::vector<size_t> sizes(numCodeBlocks, symbolSize * (numSymbols / numCodeBlocks));
+    for(size_t codeBlock = numCodeBlocks - numLargerBlocks; codeBlock < numCodeBlocks; ++codeBlock)
+    {
+        sizes[codeBlock] += symbolSize;
+    }
+
+    return sizes;
+}
+
+LTERateMatchingTable::LTERateMatchingTable(
+    size_t blockSize,
+    size_t numFillerBits,
+    size_t circularBufferSize
+):
+    _blockSize(blockSize),
+    _numFillerBits(numFillerBits),
+    _circularBufferSize(circularBufferSize)
+{
+    if(!isLTETurboBlockSize(blockSize))
+    {
+        throw Pothos::InvalidArgumentException("Invalid turbo code block size", std::to_string(blockSize));
+    }
+
+    const size_t numRows = getNumRows(blockSize);
+    const size_t subBlockSize = NumColumns * numRows;
+    const size_t numDummyBits = subBlockSize - (blockSize + 4);
+
+    // The interleaved sub-block bit from the given row-padded index, whose
+    // first numDummyBits bits are dummy bits. Only the first two streams
+    // have filler bits, since the third comes from the interleaved bits.
+    auto getBit = [&](size_t stream, size_t paddedIndex) -> std::uint16_t
+    {
+        if(paddedIndex < numDummyBits) return NullBit;
+
+        const size_t index = paddedIndex - numDummyBits;
+        if((stream < 2) && (index < numFillerBits)) return NullBit;
+
+        return static_cast<std::uint16_t>((index << 2) | stream);
+    };
+
+    // Bit collection puts the first stream's sub-block first, followed by
+    // the other two's interlaced, and the third stream's sub-block
+    // interleaver is offset by one.
+    std::vector<std::uint16_t> circularBuffer(NumStreams * subBlockSize);
+    for(size_t k = 0; k < subBlockSize; ++k)
+    {
+        const size_t paddedIndex = ColumnPermutation[k / numRows] + (NumColumns * (k % numRows));
+
+        circularBuffer[k] = getBit(0, paddedIndex);
+        circularBuffer[subBlockSize + (2 * k)] = getBit(1, paddedIndex);
+        circularBuffer[subBlockSize + (2 * k) + 1] = getBit(2, (paddedIndex + 1) % subBlockSize);
+    }
+
+    // Each redundancy version starts at a multiple of two rows, skipping
+    // any null bits there.
+    const size_t rvStep = 2 * numRows * ((circularBufferSize + (8 * numRows) - 1) / (8 * numRows));
+    size_t rvOffsets[LTENumRedundancyVersions];
+    for(size_t rv = 0; rv < LTENumRedundancyVersions; ++rv)
+    {
+        rvOffsets[rv] = ((rvStep * rv) + (2 * numRows)) % circularBufferSize;
+    }
+
+    _bits.reserve(circularBufferSize);
+    for(size_t k = 0; k < circularBufferSize; ++k)
+    {
+        for(size_t rv = 0; rv < LTENumRedundancyVersions; ++rv)
+        {
+            if(rvOffsets[rv] == k) _rvStarts[rv] = _bits.size();
+        }
+
+        if(NullBit != circularBuffer[k]) _bits.emplace_back(circularBuffer[k]);
+    }
+
+    if(_bits.empty())
+    {
+        throw Pothos::InvalidArgumentException(
+                  "The circular buffer is too small to hold any bits",
+                  std::to_string(circularBufferSize));
+    }
+}
+
+void LTERateMatchingTable::rateMatch(
+    size_t rv,
+    const std::uint8_t* const* streams,
+    size_t outputSize,
+    std::uint8_t* output) const
+{
+    const auto* bits = _bits.data();
+    const size_t numBits = _bits.size();
+
+    // Each pass runs until the end of the buffer, so only the start of the
+    // first one isn't 0.
+    size_t start = _rvStarts[rv];
+    for(size_t outputIndex = 0; outputIndex < outputSize; start = 0)
+    {
+        const size_t passSize = std::min(outputSize - outputIndex, numBits - start);
+        for(size_t i = 0; i < passSize; ++i)
+        {
+            const auto bit = bits[start + i];
+            output[outputIndex + i] = streams[bit & 3][bit >> 2];
+        }
+
+        outputIndex += passSize;
+    }
+}
+
+void LTERateMatchingTable::rateDematch(
+    size_t rv,
+    const std::int8_t* input,
+    size_t inputSize,
+    std::int8_t* const* streams) const
+{
+    const auto* bits = _bits.data();
+    const size_t numBits = _bits.size();
+    const size_t streamLength = _blockSize + 4;
+
+    for(size_t stream = 0; stream < NumStreams; ++stream)
+    {
+        std::fill(streams[stream], streams[stream] + streamLength, 0);
+    }
+    std::fill(streams[0], streams[0] + _numFillerBits, LTEFillerSoftBit);
+    std::fill(streams[1], streams[1] + _numFillerBits, LTEFillerSoftBit);
+
+    // No bit appears twice in one pass, so the first pass can just copy.
+    size_t start = _rvStarts[rv];
+    for(size_t inputIndex = 0; inputIndex < inputSize; start = 0)
+    {
+        const size_t passSize = std::min(inputSize - inputIndex, numBits - start);
+        if(0 == inputIndex)
+        {
+            for(size_t i = 0; i < passSize; ++i)
+            {
+                const auto bit = bits[start + i];
+                streams[bit & 3][bit >> 2] = input[i];
+            }
+        }
+        else
+        {
+            for(size_t i = 0; i < passSize; ++i)
+            {
+                const auto bit = bits[start + i];
+                auto& softBit = streams[bit & 3][bit >> 2];
+                softBit = static_cast<std::int8_t>(std::max<int>(-128, std::min<int>(127, softBit + input[inputIndex + i])));
+            }
+        }
+
+        inputIndex += passSize;
+    }
+}
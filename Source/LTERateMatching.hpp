@@ -0,0 +1,96 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//
+// Rate matching for turbo coded transport channels, from TS 36.212
+// section 5.1.4.1. All bits are unpacked, one per byte.
+//
+
+static constexpr size_t LTENumRedundancyVersions = 4;
+
+// The soft bit dematching gives filler bits, which are known to be 0
+static constexpr std::int8_t LTEFillerSoftBit = -127;
+
+// The number of bits of each code block's circular buffer that bit
+// selection wraps around, Ncb. A soft buffer size of 0 means it's
+// unlimited, as for uplink transport channels. Throws
+// Pothos::InvalidArgumentException if the soft buffer is too small to hold
+// anything.
+size_t calcLTECircularBufferSize(
+    size_t blockSize,
+    size_t numCodeBlocks,
+    size_t softBufferSize);
+
+// Splits a transport block's rate-matched bits, G, between its code blocks.
+// Throws Pothos::InvalidArgumentException if they don't divide into whole
+// modulation symbols on every layer.
+std::vector<size_t> calcLTERateMatchedSizes(
+    size_t numCodeBlocks,
+    size_t numOutputBits,
+    size_t modulationOrder,
+    size_t numLayers);
+
+// Sub-block interleaving, bit collection, and bit selection for one size
+// of code block, precomputed as a table of where each bit of the circular
+// buffer comes from in the encoder's three output streams.
+class LTERateMatchingTable
+{
+public:
+    // Throws Pothos::InvalidArgumentException for invalid block sizes.
+    LTERateMatchingTable(
+        size_t blockSize,
+        size_t numFillerBits,
+        size_t circularBufferSize);
+
+    inline size_t blockSize() const
+    {
+        return _blockSize;
+    }
+
+    inline size_t numFillerBits() const
+    {
+        return _numFillerBits;
+    }
+
+    inline size_t circularBufferSize() const
+    {
+        return _circularBufferSize;
+    }
+
+    // Selects outputSize bits of the circular buffer, starting where the
+    // redundancy version does, from the encoder's three streams of
+    // blockSize+4 bits. Bits are repeated once the buffer wraps around.
+    void rateMatch(
+        size_t rv,
+        const std::uint8_t* const* streams,
+        size_t outputSize,
+        std::uint8_t* output) const;
+
+    // The inverse of rateMatch, which fills in the decoder's three streams
+    // of blockSize+4 soft bits from inputSize soft bits. Bits that weren't
+    // transmitted are 0, repeated bits are added with saturation, and
+    // filler bits are LTEFillerSoftBit.
+    void rateDematch(
+        size_t rv,
+        const std::int8_t* input,
+        size_t inputSize,
+        std::int8_t* const* streams) const;
+
+private:
+    size_t _blockSize;
+    size_t _numFillerBits;
+    size_t _circularBufferSize;
+
+    // Each bit of the circular buffer, without the dummy and filler bits,
+    // as its index in its stream shifted left by two, ORed with its stream
+    std::vector<std::uint16_t> _bits;
+
+    // Where each redundancy version starts in _bits
+    size_t _rvStarts[LTENumRedundancyVersions];
+};
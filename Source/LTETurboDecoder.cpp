@@ -1,7 +1,11 @@
 // Copyright (c) 2020 Nicholas Corgan
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include "LTETurboMAPDecoder.hpp"
+#include "LTETurboUtility.hpp"
+#include "LTETurboWorkspacePool.hpp"
 #include "Utility.hpp"
+#include "WorkerPool.hpp"
 
 #include <Pothos/Exception.hpp>
 #include <Pothos/Framework.hpp>
@@ -13,36 +17,75 @@ extern "C"
 }
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <vector>
 
 using DecodeFcn = int(*)(struct tdecoder*, int, int, uint8_t*, const int8_t*, const int8_t*, const int8_t*);
 
-using tDecoderUPtr = std::unique_ptr<tdecoder, decltype(&::free_tdec)>;
-static inline tDecoderUPtr makeDecoderUPtr()
-{
-    return tDecoderUPtr(::alloc_tdec(), &free_tdec);
-}
-
 constexpr size_t calcOutputSize(size_t inputSize)
 {
     return (inputSize / 3) - 4;
 }
 
+// A labeled block waiting on the inputs
+struct QueuedBlock
+{
+    size_t inputIndex;
+    size_t inputSize;
+
+    // Only used in transport block mode
+    LTECodeBlockSegmentation segmentation;
+};
+
+// A code block within the input streams and where its decoded bits go
+struct CodeBlockJob
+{
+    size_t blockSize;
+    size_t inputIndex;
+    std::uint8_t* output;
+    bool unpack;
+    LTETurboEarlyTermination earlyTermination;
+
+    // Where the code block's LLRs go, if they're output
+    std::int16_t* llrs;
+};
+
 class LTETurboDecoder: public Pothos::Block
 {
     public:
         static Pothos::Block* make(size_t numIterations, bool unpack)
         {
-            return new LTETurboDecoder(numIterations, unpack);
+            return new LTETurboDecoder(numIterations, unpack, "");
         }
 
-        LTETurboDecoder(size_t numIterations, bool unpack):
+        static Pothos::Block* makeSoftDecoder(size_t numIterations, bool unpack, const std::string& llrDType)
+        {
+            if(llrDType.empty())
+            {
+                throw Pothos::InvalidArgumentException("The soft decoder requires an LLR type");
+            }
+
+            return new LTETurboDecoder(numIterations, unpack, llrDType);
+        }
+
+        LTETurboDecoder(size_t numIterations, bool unpack, const std::string& llrDType):
             Pothos::Block(),
             _numIterations(numIterations),
             _unpack(unpack),
-            _decodeFcn(_unpack ? ::lte_turbo_decode_unpack : ::lte_turbo_decode),
-            _tDecoderUPtr(makeDecoderUPtr())
+            _outputLLRs(!llrDType.empty()),
+            _blockStartID(),
+            _transportBlock(false),
+            _earlyTermination("None"),
+            _earlyTerminationEnum(LTETurboEarlyTermination::None),
+            _numWindows(1),
+            _radix(2),
+            _algorithm("MaxLogMAP"),
+            _algorithmEnum(LTETurboAlgorithm::MaxLogMAP),
+            _extrinsicScale(DefaultLTETurboExtrinsicScale),
+            _numDecodedBlocks(0),
+            _numDecodedIterations(0)
         {
             // Despite the function taking in int8_t*, it's immmediately casted to uint8_t*
             // internally, so for consistency with the encoder, we'll take in uint8_t* buffers.
@@ -52,13 +95,66 @@ class LTETurboDecoder: public Pothos::Block
 
             this->setupOutput(0, "uint8");
 
+            // Ports can only be set up here, so the LLR output's type is a
+            // factory parameter of the soft decoder.
+            if(_outputLLRs)
+            {
+                const Pothos::DType dtype(llrDType);
+                if((dtype != Pothos::DType("int8")) && (dtype != Pothos::DType("int16")))
+                {
+                    throw Pothos::InvalidArgumentException("The LLR type must be int8 or int16", llrDType);
+                }
+
+                this->setupOutput(1, dtype);
+            }
+
             this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, numIterations));
             this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, setNumIterations));
             this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, blockStartID));
             this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, setBlockStartID));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, transportBlock));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, setTransportBlock));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, earlyTermination));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, setEarlyTermination));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, numWindows));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, setNumWindows));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, radix));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, setRadix));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, algorithm));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, setAlgorithm));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, extrinsicScale));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, setExtrinsicScale));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboDecoder, averageIterations));
 
             this->registerProbe("numIterations");
+            this->registerProbe("transportBlock");
+            this->registerProbe("earlyTermination");
+            this->registerProbe("numWindows");
+            this->registerProbe("radix");
+            this->registerProbe("algorithm");
+            this->registerProbe("extrinsicScale");
+            this->registerProbe("averageIterations");
+
             this->registerSignal("numIterationsChanged");
+            this->registerSignal("transportBlockChanged");
+            this->registerSignal("earlyTerminationChanged");
+            this->registerSignal("numWindowsChanged");
+            this->registerSignal("radixChanged");
+            this->registerSignal("algorithmChanged");
+            this->registerSignal("extrinsicScaleChanged");
+        }
+
+        void activate() override
+        {
+            // The setters can be called in any order, so this is the first
+            // point where the two are known to be inconsistent.
+            if(_transportBlock && _blockStartID.empty())
+            {
+                throw Pothos::InvalidArgumentException("Transport block mode requires a block start ID, whose label holds the transport block size");
+            }
+
+            _numDecodedBlocks = 0;
+            _numDecodedIterations = 0;
         }
 
         size_t numIterations() const
@@ -83,6 +179,104 @@ class LTETurboDecoder: public Pothos::Block
             _blockStartID = blockStartID;
         }
 
+        bool transportBlock() const
+        {
+            return _transportBlock;
+        }
+
+        void setTransportBlock(bool transportBlock)
+        {
+            _transportBlock = transportBlock;
+
+            this->emitSignal("transportBlockChanged", _transportBlock);
+        }
+
+        std::string earlyTermination() const
+        {
+            return _earlyTermination;
+        }
+
+        void setEarlyTermination(const std::string& earlyTermination)
+        {
+            _earlyTerminationEnum = getLTETurboEarlyTermination(earlyTermination);
+            _earlyTermination = earlyTermination;
+
+            this->emitSignal("earlyTerminationChanged", _earlyTermination);
+        }
+
+        size_t numWindows() const
+        {
+            return _numWindows;
+        }
+
+        void setNumWindows(size_t numWindows)
+        {
+            if(0 == numWindows)
+            {
+                throw Pothos::InvalidArgumentException("The number of windows must be positive");
+            }
+
+            _numWindows = numWindows;
+
+            this->emitSignal("numWindowsChanged", _numWindows);
+        }
+
+        size_t radix() const
+        {
+            return _radix;
+        }
+
+        void setRadix(size_t radix)
+        {
+            if((2 != radix) && (4 != radix))
+            {
+                throw Pothos::InvalidArgumentException("The radix must be 2 or 4", std::to_string(radix));
+            }
+
+            _radix = radix;
+
+            this->emitSignal("radixChanged", _radix);
+        }
+
+        std::string algorithm() const
+        {
+            return _algorithm;
+        }
+
+        void setAlgorithm(const std::string& algorithm)
+        {
+            _algorithmEnum = getLTETurboAlgorithm(algorithm);
+            _algorithm = algorithm;
+
+            this->emitSignal("algorithmChanged", _algorithm);
+        }
+
+        double extrinsicScale() const
+        {
+            return _extrinsicScale;
+        }
+
+        void setExtrinsicScale(double extrinsicScale)
+        {
+            if((extrinsicScale <= 0.0) || (extrinsicScale > 1.0))
+            {
+                throw Pothos::InvalidArgumentException("The extrinsic scale must be in (0, 1]", std::to_string(extrinsicScale));
+            }
+
+            _extrinsicScale = extrinsicScale;
+
+            this->emitSignal("extrinsicScaleChanged", _extrinsicScale);
+        }
+
+        // The average number of iterations run per code block since
+        // activation
+        double averageIterations() const
+        {
+            const size_t numBlocks = _numDecodedBlocks;
+
+            return (numBlocks > 0) ? (double(_numDecodedIterations) / double(numBlocks)) : 0.0;
+        }
+
         void propagateLabels(const Pothos::InputPort* input) override
         {
             if(!_blockStartID.empty())
@@ -92,7 +286,7 @@ class LTETurboDecoder: public Pothos::Block
                 {
                     if(label.id != _blockStartID)
                     {
-                        this->output(0)->postLabel(label);
+                        for(auto* output: this->outputs()) output->postLabel(label);
                     }
                 }
             }
@@ -102,6 +296,14 @@ class LTETurboDecoder: public Pothos::Block
         void work() override
         {
             const auto elems = this->workInfo().minInElements;
+
+            if(_transportBlock)
+            {
+                if(0 != elems) _blockIDWork(elems);
+
+                return;
+            }
+
             if((0 == elems) || (calcOutputSize(elems) < TURBO_MIN_K))
             {
                 return;
@@ -114,45 +316,57 @@ class LTETurboDecoder: public Pothos::Block
     private:
         size_t _numIterations;
         bool _unpack;
-        DecodeFcn _decodeFcn;
-        tDecoderUPtr _tDecoderUPtr;
+        bool _outputLLRs;
 
         std::string _blockStartID;
 
-        // Common code when we've determined our input size.
-        void _work(size_t inputSize)
-        {
-            const auto& inputs = this->inputs();
-            auto output = this->output(0);
+        bool _transportBlock;
+
+        std::string _earlyTermination;
+        LTETurboEarlyTermination _earlyTerminationEnum;
 
-            const auto outputSize = calcOutputSize(inputSize);
+        size_t _numWindows;
+        size_t _radix;
 
-            _decodeFcn(
-                _tDecoderUPtr.get(),
-                static_cast<int>(outputSize),
-                static_cast<int>(_numIterations),
-                output->buffer(),
-                inputs[0]->buffer(),
-                inputs[1]->buffer(),
-                inputs[2]->buffer());
+        std::string _algorithm;
+        LTETurboAlgorithm _algorithmEnum;
+        double _extrinsicScale;
 
-            for(auto* input: inputs) input->consume(inputSize);
-            output->produce(_unpack ? outputSize : (outputSize / 8));
+        std::atomic<size_t> _numDecodedBlocks;
+        std::atomic<size_t> _numDecodedIterations;
 
-            // Output a start block ID so an decoder can operate on the same data.
-            if(!_blockStartID.empty()) output->postLabel(_blockStartID, outputSize, 0);
+        // Only used in transport block mode. These are resized for each
+        // batch, so they only allocate when a larger one arrives.
+        std::vector<std::uint8_t> _codeBlocks;
+        std::vector<std::uint8_t> _transportBlockWithCRC;
+
+        // Only used when outputting LLRs, laid out like the decoded bits
+        // before they're packed or reassembled
+        std::vector<std::int16_t> _codeBlockLLRs;
+        std::vector<std::int16_t> _transportBlockLLRs;
+
+        // Decodes the entire buffer as one code block.
+        void _work(size_t inputSize)
+        {
+            QueuedBlock block{};
+            block.inputIndex = 0;
+            block.inputSize = inputSize;
+
+            this->_decodeBlocks(std::vector<QueuedBlock>{block});
         }
 
+        // Gathers every complete labeled block on the inputs, so they can
+        // all be decoded in parallel.
         void _blockIDWork(size_t maxInputSize)
         {
-            size_t inputSize = maxInputSize;
-
             const auto& inputs = this->inputs();
+            const auto maxOutputSize = this->output(0)->elements();
 
-            bool blockFound = false;
+            std::vector<QueuedBlock> blocks;
+            size_t outputSize = 0;
 
             // We take in three inputs, but input 0 is expected to have
-            // the block ID label.
+            // the block ID labels.
             for(const auto& label: inputs[0]->labels())
             {
                 // Skip if we haven't received enough data for this label.
@@ -161,41 +375,359 @@ class LTETurboDecoder: public Pothos::Block
                 // Skip if this isn't a block start label.
                 if(label.id != _blockStartID) continue;
 
-                // If we have a length, use it.
-                if(label.data.canConvert(typeid(size_t)))
+                // Skip labels inside the last block we gathered.
+                if(!blocks.empty() && (label.index < (blocks.back().inputIndex + blocks.back().inputSize))) continue;
+
+                QueuedBlock block{};
+                block.inputIndex = label.index;
+
+                if(_transportBlock)
                 {
-                    inputSize = label.data.convert<size_t>();
-                    if(calcOutputSize(inputSize) > TURBO_MAX_K)
+                    if(!label.data.canConvert(typeid(size_t)))
                     {
-                        throw Pothos::InvalidArgumentException("Input length corresponds to an invalid block size. Max block size: " + std::to_string(TURBO_MAX_K));
+                        throw Pothos::InvalidArgumentException("In transport block mode, the block start label must hold the transport block size");
+                    }
+
+                    block.segmentation = calcLTECodeBlockSegmentation(label.data.convert<size_t>());
+                    block.inputSize = block.segmentation.totalCodeBlockSize() + (block.segmentation.numCodeBlocks * 4);
+                }
+                else
+                {
+                    // If we have a length, use it.
+                    block.inputSize = maxInputSize - label.index;
+                    if(label.data.canConvert(typeid(size_t)))
+                    {
+                        block.inputSize = label.data.convert<size_t>();
+                        if(calcOutputSize(block.inputSize) > TURBO_MAX_K)
+                        {
+                            throw Pothos::InvalidArgumentException("Input length corresponds to an invalid block size. Max block size: " + std::to_string(TURBO_MAX_K));
+                        }
                     }
                 }
 
-                // Skip all data before the block starts.
-                if(0 != label.index)
+                const auto blockOutputSize = this->_calcBlockOutputSize(block);
+
+                if(blocks.empty())
                 {
-                    for(auto* input: inputs)
+                    // Skip all data before the block starts.
+                    if(0 != label.index)
+                    {
+                        for(auto* input: inputs)
+                        {
+                            input->consume(label.index);
+                            input->setReserve(block.inputSize);
+                        }
+                        return;
+                    }
+
+                    // If our block starts at the beginning of our buffer, wait until we have
+                    // enough data to decode.
+                    if(maxInputSize < block.inputSize)
                     {
-                        input->consume(label.index);
-                        input->setReserve(inputSize);
+                        for(auto* input: inputs) input->setReserve(block.inputSize);
+                        return;
                     }
-                    return;
                 }
 
-                // If our block starts at the beginning of our buffer, wait until we have
-                // enough data to encode.
-                if(maxInputSize < inputSize)
+                // Leave any blocks that aren't complete or don't fit in the
+                // output buffer for the next call.
+                else if(((block.inputIndex + block.inputSize) > maxInputSize) || ((outputSize + blockOutputSize) > maxOutputSize))
                 {
-                    for(auto* input: inputs) input->setReserve(inputSize);
-                    return;
+                    break;
                 }
 
-                blockFound = true;
-                break;
+                blocks.emplace_back(block);
+                outputSize += blockOutputSize;
             }
 
-            if(blockFound) this->_work(inputSize);
-            else           for(auto* input: inputs) input->consume(maxInputSize);
+            if(!blocks.empty()) this->_decodeBlocks(blocks);
+            else                for(auto* input: inputs) input->consume(maxInputSize);
+        }
+
+        size_t _calcBlockDecodedSize(const QueuedBlock& block) const
+        {
+            return _transportBlock ? block.segmentation.transportBlockSize : calcOutputSize(block.inputSize);
+        }
+
+        size_t _calcBlockOutputSize(const QueuedBlock& block) const
+        {
+            const auto decodedSize = this->_calcBlockDecodedSize(block);
+
+            // A packed transport block's last byte is padded with zeros.
+            return _unpack ? decodedSize : ((decodedSize + 7) / 8);
+        }
+
+        // Decodes every code block of the given blocks in parallel, then
+        // outputs them in order.
+        void _decodeBlocks(const std::vector<QueuedBlock>& blocks)
+        {
+            const auto& inputs = this->inputs();
+            auto output = this->output(0);
+
+            size_t outputSize = 0;
+            for(const auto& block: blocks) outputSize += this->_calcBlockOutputSize(block);
+
+            // A single transport block can be larger than the output buffer.
+            const bool mustPostBuffer = (outputSize > output->elements());
+            auto outputBuffer = mustPostBuffer ? Pothos::BufferChunk("uint8", outputSize) : output->buffer();
+            auto* outBuff = outputBuffer.as<std::uint8_t*>();
+
+            // Every code block's LLRs are decoded into _codeBlockLLRs, in the
+            // same order as the code blocks.
+            size_t numCodeBlockBits = 0;
+            for(const auto& block: blocks)
+            {
+                numCodeBlockBits += _transportBlock ? block.segmentation.totalCodeBlockSize() : calcOutputSize(block.inputSize);
+            }
+            if(_outputLLRs) _codeBlockLLRs.resize(numCodeBlockBits);
+
+            std::vector<CodeBlockJob> jobs;
+            if(_transportBlock)
+            {
+                // Transport blocks are decoded unpacked into _codeBlocks and
+                // then reassembled.
+                _codeBlocks.resize(numCodeBlockBits);
+
+                size_t codeBlockStart = 0;
+                for(const auto& block: blocks)
+                {
+                    const auto& segmentation = block.segmentation;
+
+                    // The code block CRCs only exist if the transport block
+                    // was segmented.
+                    auto earlyTermination = _earlyTerminationEnum;
+                    if((LTETurboEarlyTermination::CRC24A == earlyTermination) || (LTETurboEarlyTermination::CRC24B == earlyTermination))
+                    {
+                        earlyTermination = (segmentation.numCodeBlocks > 1) ? LTETurboEarlyTermination::CRC24B : LTETurboEarlyTermination::CRC24A;
+                    }
+
+                    for(size_t codeBlock = 0; codeBlock < segmentation.numCodeBlocks; ++codeBlock)
+                    {
+                        const auto codeBlockIndex = codeBlockStart + segmentation.codeBlockStart(codeBlock);
+
+                        jobs.emplace_back(CodeBlockJob{
+                            segmentation.codeBlockSize(codeBlock),
+                            block.inputIndex + segmentation.codeBlockStart(codeBlock) + (codeBlock * 4),
+                            &_codeBlocks[codeBlockIndex],
+                            true,
+                            earlyTermination,
+                            _outputLLRs ? &_codeBlockLLRs[codeBlockIndex] : nullptr});
+                    }
+
+                    codeBlockStart += segmentation.totalCodeBlockSize();
+                }
+            }
+            else
+            {
+                size_t outputIndex = 0;
+                size_t llrIndex = 0;
+                for(const auto& block: blocks)
+                {
+                    jobs.emplace_back(CodeBlockJob{
+                        calcOutputSize(block.inputSize),
+                        block.inputIndex,
+                        outBuff + outputIndex,
+                        _unpack,
+                        _earlyTerminationEnum,
+                        _outputLLRs ? &_codeBlockLLRs[llrIndex] : nullptr});
+
+                    outputIndex += this->_calcBlockOutputSize(block);
+                    llrIndex += calcOutputSize(block.inputSize);
+                }
+            }
+
+            this->_decodeCodeBlocks(jobs);
+
+            size_t outputIndex = 0;
+            size_t codeBlockStart = 0;
+            for(const auto& block: blocks)
+            {
+                const auto blockOutputSize = this->_calcBlockOutputSize(block);
+
+                if(_transportBlock)
+                {
+                    const auto& segmentation = block.segmentation;
+
+                    _transportBlockWithCRC.resize(segmentation.transportBlockSize + LTECRCLength);
+                    getLTETransportBlock(segmentation, &_codeBlocks[codeBlockStart], _transportBlockWithCRC.data());
+                    codeBlockStart += segmentation.totalCodeBlockSize();
+
+                    if(_unpack) std::copy(_transportBlockWithCRC.begin(), _transportBlockWithCRC.begin() + blockOutputSize, outBuff + outputIndex);
+                    else        packBits(_transportBlockWithCRC.data(), segmentation.transportBlockSize, outBuff + outputIndex);
+                }
+
+                // Output a start block ID so an decoder can operate on the same data.
+                if(!_blockStartID.empty())
+                {
+                    const auto labelData = _transportBlock ? block.segmentation.transportBlockSize : calcOutputSize(block.inputSize);
+                    output->postLabel(_blockStartID, labelData, outputIndex);
+                }
+
+                outputIndex += blockOutputSize;
+            }
+
+            if(_outputLLRs) this->_outputBlockLLRs(blocks);
+
+            const auto& lastBlock = blocks.back();
+            for(auto* input: inputs) input->consume(lastBlock.inputIndex + lastBlock.inputSize);
+
+            if(mustPostBuffer) output->postBuffer(std::move(outputBuffer));
+            else               output->produce(outputSize);
+        }
+
+        // Outputs one LLR per decoded bit, in the same order and with the
+        // same labels as the decoded bits.
+        void _outputBlockLLRs(const std::vector<QueuedBlock>& blocks)
+        {
+            auto output = this->output(1);
+
+            size_t outputSize = 0;
+            for(const auto& block: blocks) outputSize += this->_calcBlockDecodedSize(block);
+
+            const bool mustPostBuffer = (outputSize > output->elements());
+            auto outputBuffer = mustPostBuffer ? Pothos::BufferChunk(output->dtype(), outputSize) : output->buffer();
+
+            size_t outputIndex = 0;
+            size_t codeBlockStart = 0;
+            for(const auto& block: blocks)
+            {
+                const auto blockOutputSize = this->_calcBlockDecodedSize(block);
+                const std::int16_t* llrs = &_codeBlockLLRs[codeBlockStart];
+
+                if(_transportBlock)
+                {
+                    const auto& segmentation = block.segmentation;
+
+                    _transportBlockLLRs.resize(segmentation.transportBlockSize + LTECRCLength);
+                    getLTETransportBlock(segmentation, llrs, _transportBlockLLRs.data());
+                    codeBlockStart += segmentation.totalCodeBlockSize();
+
+                    llrs = _transportBlockLLRs.data();
+                }
+                else codeBlockStart += blockOutputSize;
+
+                if(output->dtype() == Pothos::DType("int8"))
+                {
+                    saturateLLRs(llrs, blockOutputSize, outputBuffer.as<std::int8_t*>() + outputIndex);
+                }
+                else std::copy(llrs, llrs + blockOutputSize, outputBuffer.as<std::int16_t*>() + outputIndex);
+
+                if(!_blockStartID.empty()) output->postLabel(_blockStartID, blockOutputSize, outputIndex);
+
+                outputIndex += blockOutputSize;
+            }
+
+            if(mustPostBuffer) output->postBuffer(std::move(outputBuffer));
+            else               output->produce(outputSize);
+        }
+
+        // The code blocks are independent, so they're decoded in parallel,
+        // with at most one task per thread. Each task checks out its own
+        // workspace for as long as it runs, so idle blocks hold none.
+        void _decodeCodeBlocks(const std::vector<CodeBlockJob>& jobs)
+        {
+            auto& workerPool = WorkerPool::global();
+
+            const auto& inputs = this->inputs();
+            const std::int8_t* inBuffs[] =
+            {
+                inputs[0]->buffer().as<const std::int8_t*>(),
+                inputs[1]->buffer().as<const std::int8_t*>(),
+                inputs[2]->buffer().as<const std::int8_t*>()
+            };
+
+            const auto numTasks = std::min(jobs.size(), workerPool.numWorkers() + 1);
+
+            std::atomic<size_t> nextJob(0);
+            workerPool.parallelFor(
+                numTasks,
+                [&](size_t)
+                {
+                    auto workspace = LTETurboWorkspacePool::global().checkOut();
+
+                    for(size_t job = nextJob++; job < jobs.size(); job = nextJob++)
+                    {
+                        this->_decodeCodeBlock(*workspace, inBuffs, jobs[job]);
+                    }
+                });
+        }
+
+        // TurboFEC's decoder always runs every iteration of max-log-MAP
+        // over the whole trellis, one step at a time, and only outputs
+        // hard decisions, so anything else needs our own.
+        bool _needsMAPDecoder(const CodeBlockJob& job) const
+        {
+            return (nullptr != job.llrs)
+                || (LTETurboEarlyTermination::None != job.earlyTermination)
+                || (_numWindows > 1)
+                || (4 == _radix)
+                || (LTETurboAlgorithm::MaxLogMAP != _algorithmEnum);
+        }
+
+        void _decodeCodeBlock(
+            LTETurboWorkspace& workspace,
+            const std::int8_t* const* inBuffs,
+            const CodeBlockJob& job)
+        {
+            const auto* d0 = inBuffs[0] + job.inputIndex;
+            const auto* d1 = inBuffs[1] + job.inputIndex;
+            const auto* d2 = inBuffs[2] + job.inputIndex;
+
+            size_t numIterations = _numIterations;
+
+            if(this->_needsMAPDecoder(job))
+            {
+                auto& mapDecoder = workspace.mapDecoder();
+                auto* decodedBits = job.unpack ? job.output : workspace.decodedBits();
+
+                mapDecoder.setEarlyTermination(job.earlyTermination);
+                mapDecoder.setNumWindows(_numWindows);
+                mapDecoder.setRadix(_radix);
+                mapDecoder.setAlgorithm(_algorithmEnum);
+                mapDecoder.setExtrinsicScale(_extrinsicScale);
+                numIterations = mapDecoder.decode(job.blockSize, _numIterations, d0, d1, d2, decodedBits, job.llrs);
+
+                // Match TurboFEC's packed output.
+                if(!job.unpack) packBits(decodedBits, job.blockSize, job.output);
+            }
+            else
+            {
+                DecodeFcn decodeFcn = job.unpack ? ::lte_turbo_decode_unpack : ::lte_turbo_decode;
+                decodeFcn(
+                    workspace.tDecoder(),
+                    static_cast<int>(job.blockSize),
+                    static_cast<int>(_numIterations),
+                    job.output,
+                    d0,
+                    d1,
+                    d2);
+            }
+
+            ++_numDecodedBlocks;
+            _numDecodedIterations += numIterations;
+        }
+
+        static void saturateLLRs(const std::int16_t* llrs, size_t numLLRs, std::int8_t* output)
+        {
+            for(size_t i = 0; i < numLLRs; ++i)
+            {
+                output[i] = static_cast<std::int8_t>(std::max<int>(-127, std::min<int>(127, llrs[i])));
+            }
+        }
+
+        // Packs bits MSB-first into bytes, padding the last byte with zeros.
+        static void packBits(const std::uint8_t* bits, size_t numBits, std::uint8_t* output)
+        {
+            for(size_t byte = 0; byte < ((numBits + 7) / 8); ++byte)
+            {
+                std::uint8_t packedByte = 0;
+                for(size_t bit = (byte * 8); bit < ((byte + 1) * 8); ++bit)
+                {
+                    packedByte = (packedByte << 1) | ((bit < numBits) ? bits[bit] : 0);
+                }
+
+                output[byte] = packedByte;
+            }
         }
 };
 
@@ -206,6 +738,13 @@ class LTETurboDecoder: public Pothos::Block
  * |keywords coder
  * |factory /fec/lte_turbo_decoder(numIterations,unpack)
  * |setter setNumIterations(numIterations)
+ * |setter setBlockStartID(blockStartID)
+ * |setter setTransportBlock(transportBlock)
+ * |setter setEarlyTermination(earlyTermination)
+ * |setter setNumWindows(numWindows)
+ * |setter setRadix(radix)
+ * |setter setAlgorithm(algorithm)
+ * |setter setExtrinsicScale(extrinsicScale)
  *
  * |param numIterations[Num Iterations]
  * |widget SpinBox(minimum=1)
@@ -213,6 +752,9 @@ class LTETurboDecoder: public Pothos::Block
  * |preview enable
  *
  * |param unpack[Unpack?]
+ * When false, the decoded bits are packed MSB-first into bytes. In transport block
+ * mode, each transport block starts a new byte, and any bits of its last byte past
+ * the transport block are zero.
  * |widget ToggleSwitch(on="True",off="False")
  * |default true
  * |preview enable
@@ -221,11 +763,203 @@ class LTETurboDecoder: public Pothos::Block
  * The label used by the block to determine the beginning of the block to decode.
  * This label will be placed at the start of the corresponding encoded block.
  * If the given string is empty, the block will decode the entire
- * input buffer at once.
+ * input buffer at once. Every complete block waiting on the inputs is decoded
+ * in parallel.
  * |widget LineEdit()
  * |default "START"
  * |preview disable
+ *
+ * |param transportBlock[Transport Block?]
+ * When set to true, each block is a transport block from an LTE Turbo Encoder in
+ * transport block mode, whose block start label holds the transport block size.
+ * Its code blocks are decoded in parallel and reassembled into the transport block,
+ * without its CRC24A. This requires a block start ID.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param earlyTermination[Early Termination]
+ * When to stop iterating on a code block before running all of the iterations.
+ * "CRC24A" stops once the decoded bits' trailing CRC24A checks out, as for a
+ * whole transport block, and "CRC24B" does the same for a code block segmented
+ * from a transport block. In transport block mode, either CRC uses whichever
+ * one each code block ends with. "Convergence" stops once an iteration's hard
+ * decisions match the last one's. Anything other than "None" uses the block's
+ * own max-log-MAP decoder instead of TurboFEC's.
+ * |widget ComboBox(editable=false)
+ * |option [None] "None"
+ * |option [CRC24A] "CRC24A"
+ * |option [CRC24B] "CRC24B"
+ * |option [Convergence] "Convergence"
+ * |default "None"
+ * |preview disable
+ *
+ * |param numWindows[Num Windows]
+ * The number of windows to split each code block's trellis into, which are decoded
+ * in parallel to cut the latency of large code blocks. Each window starts from where
+ * its neighbors ended in the last iteration, which can cost an extra iteration.
+ * Windows are never shorter than 64 bits. Anything over 1 uses the block's own
+ * max-log-MAP decoder instead of TurboFEC's.
+ * |widget SpinBox(minimum=1)
+ * |default 1
+ * |preview disable
+ *
+ * |param radix[Radix]
+ * The number of trellis branches each step of the MAP recursions takes. A radix of 4
+ * takes two trellis steps at once, which halves the length of the recursions' serial
+ * dependency chain with the same results. Whether that's faster depends on the CPU.
+ * A radix of 4 uses the block's own max-log-MAP decoder instead of TurboFEC's.
+ * |widget ComboBox(editable=false)
+ * |option [Radix-2] 2
+ * |option [Radix-4] 4
+ * |default 2
+ * |preview disable
+ *
+ * |param algorithm[Algorithm]
+ * How the MAP recursions combine the paths through the trellis. Max-Log-MAP only
+ * counts the best path. Scaled Max-Log-MAP also scales down the extrinsic LLRs passed
+ * between the constituent decoders by the extrinsic scale, which usually reaches the
+ * same error rate in one fewer iteration, at almost no cost. Log-MAP counts every path,
+ * using a table for the correction term, which gains a fraction of a dB at a few times
+ * the cost. The table assumes soft bits are LLRs with 8 steps per nat. Anything other
+ * than Max-Log-MAP uses the block's own decoder instead of TurboFEC's.
+ * |widget ComboBox(editable=false)
+ * |option [Max-Log-MAP] "MaxLogMAP"
+ * |option [Scaled Max-Log-MAP] "ScaledMaxLogMAP"
+ * |option [Log-MAP] "LogMAP"
+ * |default "MaxLogMAP"
+ * |preview disable
+ *
+ * |param extrinsicScale[Extrinsic Scale]
+ * What Scaled Max-Log-MAP scales the extrinsic LLRs by, in (0, 1].
+ * |widget DoubleSpinBox(minimum=0.05,maximum=1.0,step=0.05,decimals=2)
+ * |default 0.75
+ * |preview disable
  */
 static Pothos::BlockRegistry registerLTETurboDecoder(
     "/fec/lte_turbo_decoder",
     Pothos::Callable(&LTETurboDecoder::make));
+
+/*
+ * |PothosDoc LTE Turbo Soft Decoder
+ *
+ * An LTE Turbo Decoder that also outputs the LLR of every decoded bit on a second
+ * output, for soft-input processing downstream. It always uses the block's own
+ * max-log-MAP decoder, since TurboFEC's only outputs hard decisions.
+ *
+ * |category /FEC/LTE
+ * |keywords coder
+ * |factory /fec/lte_turbo_soft_decoder(numIterations,unpack,llrDType)
+ * |setter setNumIterations(numIterations)
+ * |setter setBlockStartID(blockStartID)
+ * |setter setTransportBlock(transportBlock)
+ * |setter setEarlyTermination(earlyTermination)
+ * |setter setNumWindows(numWindows)
+ * |setter setRadix(radix)
+ * |setter setAlgorithm(algorithm)
+ * |setter setExtrinsicScale(extrinsicScale)
+ *
+ * |param numIterations[Num Iterations]
+ * |widget SpinBox(minimum=1)
+ * |default 4
+ * |preview enable
+ *
+ * |param unpack[Unpack?]
+ * When false, the decoded bits are packed MSB-first into bytes. In transport block
+ * mode, each transport block starts a new byte, and any bits of its last byte past
+ * the transport block are zero.
+ * |widget ToggleSwitch(on="True",off="False")
+ * |default true
+ * |preview enable
+ *
+ * |param llrDType[LLR Type]
+ * The type of the second output, which holds the a posteriori LLR of every decoded bit,
+ * in the same order and with the same labels as the unpacked bits, where positive
+ * values correspond to 1. The LLRs are in the same units as the soft bits, and int8
+ * LLRs saturate at +/-127.
+ * |widget ComboBox(editable=false)
+ * |option [Int8] "int8"
+ * |option [Int16] "int16"
+ * |default "int8"
+ * |preview enable
+ *
+ * |param blockStartID[Block Start ID]
+ * The label used by the block to determine the beginning of the block to decode.
+ * This label will be placed at the start of the corresponding encoded block.
+ * If the given string is empty, the block will decode the entire
+ * input buffer at once. Every complete block waiting on the inputs is decoded
+ * in parallel.
+ * |widget LineEdit()
+ * |default "START"
+ * |preview disable
+ *
+ * |param transportBlock[Transport Block?]
+ * When set to true, each block is a transport block from an LTE Turbo Encoder in
+ * transport block mode, whose block start label holds the transport block size.
+ * Its code blocks are decoded in parallel and reassembled into the transport block,
+ * without its CRC24A. This requires a block start ID.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
+ *
+ * |param earlyTermination[Early Termination]
+ * When to stop iterating on a code block before running all of the iterations.
+ * "CRC24A" stops once the decoded bits' trailing CRC24A checks out, as for a
+ * whole transport block, and "CRC24B" does the same for a code block segmented
+ * from a transport block. In transport block mode, either CRC uses whichever
+ * one each code block ends with. "Convergence" stops once an iteration's hard
+ * decisions match the last one's. Anything other than "None" uses the block's
+ * own max-log-MAP decoder instead of TurboFEC's.
+ * |widget ComboBox(editable=false)
+ * |option [None] "None"
+ * |option [CRC24A] "CRC24A"
+ * |option [CRC24B] "CRC24B"
+ * |option [Convergence] "Convergence"
+ * |default "None"
+ * |preview disable
+ *
+ * |param numWindows[Num Windows]
+ * The number of windows to split each code block's trellis into, which are decoded
+ * in parallel to cut the latency of large code blocks. Each window starts from where
+ * its neighbors ended in the last iteration, which can cost an extra iteration.
+ * Windows are never shorter than 64 bits. Anything over 1 uses the block's own
+ * max-log-MAP decoder instead of TurboFEC's.
+ * |widget SpinBox(minimum=1)
+ * |default 1
+ * |preview disable
+ *
+ * |param radix[Radix]
+ * The number of trellis branches each step of the MAP recursions takes. A radix of 4
+ * takes two trellis steps at once, which halves the length of the recursions' serial
+ * dependency chain with the same results. Whether that's faster depends on the CPU.
+ * A radix of 4 uses the block's own max-log-MAP decoder instead of TurboFEC's.
+ * |widget ComboBox(editable=false)
+ * |option [Radix-2] 2
+ * |option [Radix-4] 4
+ * |default 2
+ * |preview disable
+ *
+ * |param algorithm[Algorithm]
+ * How the MAP recursions combine the paths through the trellis. Max-Log-MAP only
+ * counts the best path. Scaled Max-Log-MAP also scales down the extrinsic LLRs passed
+ * between the constituent decoders by the extrinsic scale, which usually reaches the
+ * same error rate in one fewer iteration, at almost no cost. Log-MAP counts every path,
+ * using a table for the correction term, which gains a fraction of a dB at a few times
+ * the cost. The table assumes soft bits are LLRs with 8 steps per nat. Anything other
+ * than Max-Log-MAP uses the block's own decoder instead of TurboFEC's.
+ * |widget ComboBox(editable=false)
+ * |option [Max-Log-MAP] "MaxLogMAP"
+ * |option [Scaled Max-Log-MAP] "ScaledMaxLogMAP"
+ * |option [Log-MAP] "LogMAP"
+ * |default "MaxLogMAP"
+ * |preview disable
+ *
+ * |param extrinsicScale[Extrinsic Scale]
+ * What Scaled Max-Log-MAP scales the extrinsic LLRs by, in (0, 1].
+ * |widget DoubleSpinBox(minimum=0.05,maximum=1.0,step=0.05,decimals=2)
+ * |default 0.75
+ * |preview disable
+ */
+static Pothos::BlockRegistry registerLTETurboSoftDecoder(
+    "/fec/lte_turbo_soft_decoder",
+    Pothos::Callable(&LTETurboDecoder::makeSoftDecoder));
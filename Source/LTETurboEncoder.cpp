@@ -1,7 +1,9 @@
 // Copyright (c) 2020 Nicholas Corgan
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+#include "LTETurboUtility.hpp"
 #include "Utility.hpp"
+#include "WorkerPool.hpp"
 
 #include <Pothos/Exception.hpp>
 #include <Pothos/Framework.hpp>
@@ -14,6 +16,7 @@ extern "C"
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 constexpr size_t calcOutputSize(size_t inputSize)
 {
@@ -32,7 +35,8 @@ class LTETurboEncoder: public Pothos::Block
             Pothos::Block(),
             _rgen(rgen),
             _gen(gen),
-            _blockStartID()
+            _blockStartID(),
+            _transportBlock(false)
         {
             this->setupInput(0, "uint8");
 
@@ -46,12 +50,16 @@ class LTETurboEncoder: public Pothos::Block
             this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboEncoder, setGen));
             this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboEncoder, blockStartID));
             this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboEncoder, setBlockStartID));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboEncoder, transportBlock));
+            this->registerCall(this, POTHOS_FCN_TUPLE(LTETurboEncoder, setTransportBlock));
 
             this->registerProbe("rgen");
             this->registerProbe("gen");
+            this->registerProbe("transportBlock");
 
             this->registerSignal("rgenChanged");
             this->registerSignal("genChanged");
+            this->registerSignal("transportBlockChanged");
         }
 
         unsigned rgen() const
@@ -88,6 +96,28 @@ class LTETurboEncoder: public Pothos::Block
             _blockStartID = blockStartID;
         }
 
+        bool transportBlock() const
+        {
+            return _transportBlock;
+        }
+
+        void setTransportBlock(bool transportBlock)
+        {
+            _transportBlock = transportBlock;
+
+            this->emitSignal("transportBlockChanged", _transportBlock);
+        }
+
+        void activate() override
+        {
+            // The setters can be called in any order, so this is the first
+            // point where the two are known to be inconsistent.
+            if(_transportBlock && _blockStartID.empty())
+            {
+                throw Pothos::InvalidArgumentException("Transport block mode requires a block start ID, whose label holds the transport block size");
+            }
+        }
+
         void propagateLabels(const Pothos::InputPort* input) override
         {
             if(!_blockStartID.empty())
@@ -106,8 +136,10 @@ class LTETurboEncoder: public Pothos::Block
 
         void work() override
         {
+            // Transport blocks of any size are padded to a valid code
+            // block size.
             const auto inputSize = this->input(0)->elements();
-            if(inputSize < TURBO_MIN_K)
+            if(inputSize < (_transportBlock ? 1 : TURBO_MIN_K))
             {
                 // We don't have enough data to encode yet.
                 return;
@@ -123,9 +155,22 @@ class LTETurboEncoder: public Pothos::Block
 
         std::string _blockStartID;
 
+        bool _transportBlock;
+
+        // Only used in transport block mode. These are resized for each
+        // transport block, so they only allocate when a larger one arrives.
+        std::vector<std::uint8_t> _transportBlockWithCRC;
+        std::vector<std::uint8_t> _codeBlocks;
+
         // Common code when we've determined our input size.
         void _work(size_t inputSize)
         {
+            if(_transportBlock)
+            {
+                this->_transportBlockWork(inputSize);
+                return;
+            }
+
             auto input = this->input(0);
             const auto& outputs = this->outputs();
 
@@ -192,9 +237,13 @@ class LTETurboEncoder: public Pothos::Block
                 if(label.data.canConvert(typeid(size_t)))
                 {
                     inputSize = label.data.convert<size_t>();
-                    if(inputSize > TURBO_MAX_K)
+
+                    // Check before reserving the input, since a transport
+                    // block isn't segmented until it's all here.
+                    const size_t maxBlockSize = _transportBlock ? LTEMaxTransportBlockSize : TURBO_MAX_K;
+                    if(inputSize > maxBlockSize)
                     {
-                        throw Pothos::InvalidArgumentException("Max block size: " + std::to_string(TURBO_MAX_K));
+                        throw Pothos::InvalidArgumentException("Max block size: " + std::to_string(maxBlockSize));
                     }
                 }
 
@@ -221,6 +270,74 @@ class LTETurboEncoder: public Pothos::Block
             if(blockFound) this->_work(inputSize);
             else           input->consume(maxInputSize);
         }
+
+        // Attaches the transport block's CRC, segments it into code blocks,
+        // and encodes each one into its place in the output streams, which
+        // hold the code blocks' K+4 bits each back-to-back. The code blocks
+        // are independent, so they're encoded in parallel.
+        void _transportBlockWork(size_t transportBlockSize)
+        {
+            auto input = this->input(0);
+            const auto& outputs = this->outputs();
+
+            const auto segmentation = calcLTECodeBlockSegmentation(transportBlockSize);
+            const auto numCodeBlocks = segmentation.numCodeBlocks;
+            const auto streamLength = segmentation.totalCodeBlockSize() + (numCodeBlocks * 4);
+
+            const auto* inBuff = input->buffer().as<const std::uint8_t*>();
+            _transportBlockWithCRC.resize(transportBlockSize + LTECRCLength);
+            std::copy(inBuff, inBuff + transportBlockSize, _transportBlockWithCRC.begin());
+            writeLTECRC(
+                calcLTECRC24A(_transportBlockWithCRC.data(), transportBlockSize),
+                &_transportBlockWithCRC[transportBlockSize]);
+
+            _codeBlocks.resize(segmentation.totalCodeBlockSize());
+
+            std::vector<Pothos::BufferChunk> outputBuffers;
+            for(auto* output: outputs)
+            {
+                if(output->elements() >= streamLength) outputBuffers.emplace_back(output->buffer());
+                else                                   outputBuffers.emplace_back(Pothos::BufferChunk("uint8", streamLength));
+            }
+
+            WorkerPool::global().parallelFor(
+                numCodeBlocks,
+                [&](size_t codeBlock)
+                {
+                    const auto blockStart = segmentation.codeBlockStart(codeBlock);
+                    const auto streamStart = blockStart + (codeBlock * 4);
+                    auto* codeBlockBits = &_codeBlocks[blockStart];
+
+                    getLTECodeBlock(segmentation, _transportBlockWithCRC.data(), codeBlock, codeBlockBits);
+
+                    struct lte_turbo_code turboCode =
+                    {
+                        2, // n
+                        4, // k
+                        static_cast<int>(segmentation.codeBlockSize(codeBlock)),
+                        _rgen,
+                        _gen
+                    };
+
+                    throwOnErrCode(::lte_turbo_encode(
+                                       &turboCode,
+                                       codeBlockBits,
+                                       outputBuffers[0].as<std::uint8_t*>() + streamStart,
+                                       outputBuffers[1].as<std::uint8_t*>() + streamStart,
+                                       outputBuffers[2].as<std::uint8_t*>() + streamStart));
+                });
+
+            input->consume(transportBlockSize);
+            for(size_t port = 0; port < outputs.size(); ++port)
+            {
+                if(outputs[port]->elements() >= streamLength) outputs[port]->produce(streamLength);
+                else                                          outputs[port]->postBuffer(std::move(outputBuffers[port]));
+            }
+
+            // The decoder needs the transport block size to segment it the
+            // same way.
+            if(!_blockStartID.empty()) outputs[0]->postLabel(_blockStartID, transportBlockSize, 0);
+        }
 };
 
 /*
@@ -232,6 +349,7 @@ class LTETurboEncoder: public Pothos::Block
  * |setter setRGen(rgen)
  * |setter setGen(gen)
  * |setter setBlockStartID(blockStartID)
+ * |setter setTransportBlock(transportBlock)
  *
  * |param rgen[RGen] Recursive generator polynomial
  * |widget SpinBox(minimum=0,base=8)
@@ -251,6 +369,17 @@ class LTETurboEncoder: public Pothos::Block
  * |widget LineEdit()
  * |default "START"
  * |preview disable
+ *
+ * |param transportBlock[Transport Block?]
+ * When set to true, each block is a transport block of up to 391656 bits, as in
+ * TS 36.212. A CRC24A is attached, and the result is segmented into code blocks of
+ * valid interleaver sizes, padded with filler bits and each with a CRC24B if there
+ * is more than one. Each output port holds the code blocks' K+4 bit streams
+ * back-to-back, and the block start label's data is the transport block size. This
+ * requires a block start ID.
+ * |widget ToggleSwitch(on="True", off="False")
+ * |default false
+ * |preview disable
  */
 static Pothos::BlockRegistry registerLTETurboEncoder(
     "/fec/lte_turbo_encoder",
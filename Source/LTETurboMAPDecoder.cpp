@@ -0,0 +1,617 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "LTETurboMAPDecoder.hpp"
+#include "LTETurboUtility.hpp"
+#include "WorkerPool.hpp"
+
+#include <Pothos/Exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+static constexpr size_t NumStates = 8;
+static constexpr size_t NumTailSteps = 3;
+
+// Metrics are normalized against state 0 on every step, which bounds the
+// spread between states to a few branch metrics. Clamping the extrinsic
+// LLRs bounds the branch metrics, so everything fits in 16 bits.
+static constexpr std::int16_t InvalidMetric = -8192;
+static constexpr std::int16_t ExtrinsicLimit = 1024;
+
+// Extrinsic scaling factors are fixed-point, with this many fractional
+// bits.
+static constexpr int ExtrinsicScaleBits = 15;
+
+// Log-MAP's correction term, ln(1 + exp(-|a - b|)), rounded for soft bits
+// with 8 steps per nat, steps down by one at each of these differences.
+static const std::int16_t LogMAPCorrectionThresholds[] = {1, 3, 5, 9, 13, 22};
+
+// Shorter windows start too far from where their metrics converge.
+static constexpr size_t MinWindowSize = 64;
+static constexpr size_t MaxNumWindows = LTEMaxCodeBlockSize / MinWindowSize;
+
+LTETurboAlgorithm getLTETurboAlgorithm(const std::string& name)
+{
+    if(name == "MaxLogMAP")       return LTETurboAlgorithm::MaxLogMAP;
+    if(name == "ScaledMaxLogMAP") return LTETurboAlgorithm::ScaledMaxLogMAP;
+    if(name == "LogMAP")          return LTETurboAlgorithm::LogMAP;
+
+    throw Pothos::InvalidArgumentException("Invalid algorithm", name);
+}
+
+LTETurboEarlyTermination getLTETurboEarlyTermination(const std::string& name)
+{
+    if(name == "None")        return LTETurboEarlyTermination::None;
+    if(name == "CRC24A")      return LTETurboEarlyTermination::CRC24A;
+    if(name == "CRC24B")      return LTETurboEarlyTermination::CRC24B;
+    if(name == "Convergence") return LTETurboEarlyTermination::Convergence;
+
+    throw Pothos::InvalidArgumentException("Invalid early termination", name);
+}
+
+template <int I0, int I1, int I2, int I3, int I4, int I5, int I6, int I7>
+static inline Int16x8 shuffle(const Int16x8& vec)
+{
+#if defined(__clang__)
+    return __builtin_shufflevector(vec, vec, I0, I1, I2, I3, I4, I5, I6, I7);
+#else
+    return __builtin_shuffle(vec, Int16x8{I0, I1, I2, I3, I4, I5, I6, I7});
+#endif
+}
+
+static inline Int16x8 vectorMax(const Int16x8& vec0, const Int16x8& vec1)
+{
+    return (vec0 > vec1) ? vec0 : vec1;
+}
+
+// Log-MAP's max*(a, b) = ln(exp(a) + exp(b)) = max(a, b) + ln(1 + exp(-|a - b|)),
+// where the correction term takes one compare per table entry.
+static inline Int16x8 vectorMaxStar(const Int16x8& vec0, const Int16x8& vec1)
+{
+    const Int16x8 zeros = {0};
+    const Int16x8 diff = vec0 - vec1;
+    const Int16x8 absDiff = (diff < zeros) ? -diff : diff;
+
+    Int16x8 correction = zeros;
+    for(const auto threshold: LogMAPCorrectionThresholds)
+    {
+        correction -= (absDiff < (zeros + threshold));
+    }
+
+    return vectorMax(vec0, vec1) + correction;
+}
+
+template <bool IsLogMAP>
+static inline Int16x8 maxOf(const Int16x8& vec0, const Int16x8& vec1)
+{
+    return IsLogMAP ? vectorMaxStar(vec0, vec1) : vectorMax(vec0, vec1);
+}
+
+template <bool IsLogMAP>
+static inline int horizontalMax(Int16x8 vec)
+{
+    vec = maxOf<IsLogMAP>(vec, shuffle<4, 5, 6, 7, 0, 1, 2, 3>(vec));
+    vec = maxOf<IsLogMAP>(vec, shuffle<2, 3, 0, 1, 2, 3, 0, 1>(vec));
+    vec = maxOf<IsLogMAP>(vec, shuffle<1, 0, 1, 0, 1, 0, 1, 0>(vec));
+
+    return vec[0];
+}
+
+//
+// The constituent encoder's registers hold (r1, r2, r3), most recent first,
+// and its state is (r1 << 2) | (r2 << 1) | r3. Each step feeds back
+// a = u ^ r2 ^ r3 and outputs the parity bit z = a ^ r1 ^ r3, and the next
+// state is (a << 2) | (state >> 1). So state s's predecessors are
+// ((s & 3) << 1) and ((s & 3) << 1) | 1, and its successors are (s >> 1)
+// and 4 | (s >> 1).
+//
+// The tail steps set a = 0, so they only take the first successor.
+//
+// The trellis can be split into windows that run their recursions in
+// parallel. Only the first window's forward recursion and the last
+// window's backward recursion start from a known state. Every other window
+// starts from the metrics its neighbor ended on in the last iteration, or
+// from all states being equally likely in the first.
+//
+
+//
+// The radix-4 kernel takes two steps at once. State s's four predecessors
+// two steps back are ((s & 1) << 2) | j, through ((s & 3) << 1) | (j >> 1),
+// and its four successors two steps ahead are (j << 1) | (s >> 2), through
+// ((j & 1) << 2) | (s >> 1). Taking the max over all four paths gives the
+// same metrics as two radix-2 steps, but halves the length of the chain of
+// dependent steps. Each path's branch metric is the sum of its two steps'
+// radix-2 branch metrics, which don't depend on the chain at all.
+//
+// Log-MAP's correction term makes the order paths are combined in matter,
+// so paths through the same middle state are always combined first, as two
+// radix-2 steps would, and the middle step's forward metrics are still
+// stored for its LLRs. That keeps every algorithm's results the same as
+// radix 2's.
+//
+
+template <size_t J>
+static inline Int16x8 getRadix4Predecessors(const Int16x8& metrics)
+{
+    return shuffle<J, 4+J, J, 4+J, J, 4+J, J, 4+J>(metrics);
+}
+
+template <size_t J>
+static inline Int16x8 getRadix4Successors(const Int16x8& metrics)
+{
+    return shuffle<2*J, 2*J, 2*J, 2*J, 2*J+1, 2*J+1, 2*J+1, 2*J+1>(metrics);
+}
+
+static inline Int16x8 getEvenPredecessors(const Int16x8& metrics)
+{
+    return shuffle<0, 2, 4, 6, 0, 2, 4, 6>(metrics);
+}
+
+static inline Int16x8 getOddPredecessors(const Int16x8& metrics)
+{
+    return shuffle<1, 3, 5, 7, 1, 3, 5, 7>(metrics);
+}
+
+static inline Int16x8 getFirstSuccessors(const Int16x8& metrics)
+{
+    return shuffle<0, 0, 1, 1, 2, 2, 3, 3>(metrics);
+}
+
+static inline Int16x8 getSecondSuccessors(const Int16x8& metrics)
+{
+    return shuffle<4, 4, 5, 5, 6, 6, 7, 7>(metrics);
+}
+
+LTETurboMAPDecoder::LTETurboMAPDecoder():
+    _earlyTermination(LTETurboEarlyTermination::None),
+    _numWindows(1),
+    _radix(2),
+    _algorithm(LTETurboAlgorithm::MaxLogMAP),
+    _extrinsicScale(DefaultLTETurboExtrinsicScale),
+    _blockSize(0),
+    _extrinsic(LTEMaxCodeBlockSize),
+    _llrs(LTEMaxCodeBlockSize),
+    _forwardMetrics(LTEMaxCodeBlockSize),
+    _nextWindowForwardMetrics(MaxNumWindows),
+    _nextWindowBackwardMetrics(MaxNumWindows),
+    _lastOutput(LTEMaxCodeBlockSize)
+{
+    for(unsigned state = 0; state < NumStates; ++state)
+    {
+        const unsigned r1 = (state >> 2) & 1;
+        const unsigned r2 = (state >> 1) & 1;
+        const unsigned r3 = state & 1;
+
+        for(unsigned a = 0; a < 2; ++a)
+        {
+            _backwardSystematicMasks[a][state] = (a ^ r2 ^ r3) ? -1 : 0;
+            _backwardParityMasks[a][state] = (a ^ r1 ^ r3) ? -1 : 0;
+        }
+
+        // As a next state, this state's top bit is the feedback bit.
+        const unsigned a = state >> 2;
+        for(unsigned parity = 0; parity < 2; ++parity)
+        {
+            const unsigned prevState = ((state & 3) << 1) | parity;
+            const unsigned prevR1 = (prevState >> 2) & 1;
+            const unsigned prevR2 = (prevState >> 1) & 1;
+            const unsigned prevR3 = prevState & 1;
+
+            _forwardSystematicMasks[parity][state] = (a ^ prevR2 ^ prevR3) ? -1 : 0;
+            _forwardParityMasks[parity][state] = (a ^ prevR1 ^ prevR3) ? -1 : 0;
+        }
+    }
+
+    for(size_t decoder = 0; decoder < 2; ++decoder)
+    {
+        _systematic[decoder].resize(LTEMaxCodeBlockSize + NumTailSteps);
+        _parity[decoder].resize(LTEMaxCodeBlockSize + NumTailSteps);
+        _apriori[decoder].resize(LTEMaxCodeBlockSize);
+
+        _windowForwardMetrics[decoder] = AlignedArray<Int16x8>(MaxNumWindows);
+        _windowBackwardMetrics[decoder] = AlignedArray<Int16x8>(MaxNumWindows);
+    }
+}
+
+void LTETurboMAPDecoder::setExtrinsicScale(double extrinsicScale)
+{
+    if((extrinsicScale <= 0.0) || (extrinsicScale > 1.0))
+    {
+        throw Pothos::InvalidArgumentException("The extrinsic scale must be in (0, 1]", std::to_string(extrinsicScale));
+    }
+
+    _extrinsicScale = extrinsicScale;
+}
+
+void LTETurboMAPDecoder::setRadix(size_t radix)
+{
+    if((2 != radix) && (4 != radix))
+    {
+        throw Pothos::InvalidArgumentException("The radix must be 2 or 4", std::to_string(radix));
+    }
+
+    _radix = radix;
+}
+
+void LTETurboMAPDecoder::setNumWindows(size_t numWindows)
+{
+    if(0 == numWindows)
+    {
+        throw Pothos::InvalidArgumentException("The number of windows must be positive");
+    }
+
+    _numWindows = numWindows;
+}
+
+size_t LTETurboMAPDecoder::decode(
+    size_t blockSize,
+    size_t maxIterations,
+    const std::int8_t* d0,
+    const std::int8_t* d1,
+    const std::int8_t* d2,
+    std::uint8_t* output,
+    std::int16_t* llrs)
+{
+    if(0 == maxIterations)
+    {
+        throw Pothos::InvalidArgumentException("The number of iterations must be positive");
+    }
+
+    this->_setBlockSize(blockSize);
+
+    const size_t K = blockSize;
+
+    _extrinsicScaleFixed = (LTETurboAlgorithm::ScaledMaxLogMAP == _algorithm)
+                         ? static_cast<int>((_extrinsicScale * (1 << ExtrinsicScaleBits)) + 0.5)
+                         : (1 << ExtrinsicScaleBits);
+
+    for(size_t i = 0; i < K; ++i)
+    {
+        _systematic[0][i] = d0[i];
+        _parity[0][i] = d1[i];
+        _systematic[1][i] = d0[_interleaver[i]];
+        _parity[1][i] = d2[i];
+    }
+
+    // The tail bits are multiplexed across the three streams, the first
+    // encoder's and then the second's.
+    const std::int8_t* tailSystematic[2][NumTailSteps] =
+    {
+        {&d0[K],   &d2[K],   &d1[K+1]},
+        {&d0[K+2], &d2[K+2], &d1[K+3]},
+    };
+    const std::int8_t* tailParity[2][NumTailSteps] =
+    {
+        {&d1[K],   &d0[K+1], &d2[K+1]},
+        {&d1[K+2], &d0[K+3], &d2[K+3]},
+    };
+    for(size_t decoder = 0; decoder < 2; ++decoder)
+    {
+        for(size_t step = 0; step < NumTailSteps; ++step)
+        {
+            _systematic[decoder][K + step] = *tailSystematic[decoder][step];
+            _parity[decoder][K + step] = *tailParity[decoder][step];
+        }
+    }
+
+    std::fill(_apriori[0].begin(), _apriori[0].begin() + K, 0);
+
+    const Int16x8 zeros = {0};
+    for(size_t decoder = 0; decoder < 2; ++decoder)
+    {
+        std::fill(_windowForwardMetrics[decoder].begin(), _windowForwardMetrics[decoder].end(), zeros);
+        std::fill(_windowBackwardMetrics[decoder].begin(), _windowBackwardMetrics[decoder].end(), zeros);
+    }
+
+    size_t iteration = 0;
+    while(iteration < maxIterations)
+    {
+        ++iteration;
+
+        this->_decodeConstituent(0);
+        for(size_t i = 0; i < K; ++i) _apriori[1][i] = _extrinsic[_interleaver[i]];
+
+        this->_decodeConstituent(1);
+        for(size_t i = 0; i < K; ++i)
+        {
+            _apriori[0][_interleaver[i]] = _extrinsic[i];
+            output[_interleaver[i]] = (_llrs[i] > 0) ? 1 : 0;
+        }
+
+        if(this->_isDone(output, iteration)) break;
+    }
+
+    if(llrs)
+    {
+        for(size_t i = 0; i < K; ++i) llrs[_interleaver[i]] = _llrs[i];
+    }
+
+    return iteration;
+}
+
+void LTETurboMAPDecoder::_setBlockSize(size_t blockSize)
+{
+    if(blockSize == _blockSize) return;
+
+    _interleaver = getLTETurboInterleaver(blockSize);
+    _blockSize = blockSize;
+}
+
+void LTETurboMAPDecoder::_decodeConstituent(size_t decoder)
+{
+    const size_t K = _blockSize;
+    const size_t numWindows = std::max<size_t>(1, std::min(_numWindows, K / MinWindowSize));
+
+    const auto* systematic = _systematic[decoder].data();
+    const auto* parity = _parity[decoder].data();
+
+    const Int16x8 zeros = {0};
+    const Int16x8 invalids = zeros + InvalidMetric;
+
+    // Both ends of the trellis are in state 0, so the backward recursion
+    // through the tail gives the last window's starting metrics.
+    Int16x8 startMetrics = invalids;
+    startMetrics[0] = 0;
+
+    Int16x8 backwardMetrics = startMetrics;
+    for(size_t step = K + NumTailSteps; step-- > K;)
+    {
+        const Int16x8 systematicLLR = zeros + systematic[step];
+        const Int16x8 parityLLR = zeros + parity[step];
+
+        backwardMetrics = getFirstSuccessors(backwardMetrics)
+                        + (_backwardSystematicMasks[0] & systematicLLR)
+                        + (_backwardParityMasks[0] & parityLLR);
+        backwardMetrics -= (zeros + backwardMetrics[0]);
+    }
+
+    _windowForwardMetrics[decoder][0] = startMetrics;
+    _windowBackwardMetrics[decoder][numWindows - 1] = backwardMetrics;
+
+    WorkerPool::global().parallelFor(
+        numWindows,
+        [&](size_t window)
+        {
+            const bool isLogMAP = (LTETurboAlgorithm::LogMAP == _algorithm);
+
+            if(4 == _radix)
+            {
+                if(isLogMAP) this->_decodeWindowRadix4<true>(decoder, window, numWindows);
+                else         this->_decodeWindowRadix4<false>(decoder, window, numWindows);
+            }
+            else
+            {
+                if(isLogMAP) this->_decodeWindow<true>(decoder, window, numWindows);
+                else         this->_decodeWindow<false>(decoder, window, numWindows);
+            }
+        });
+
+    // Only now that every window has read its starting metrics can they
+    // be replaced for the next iteration.
+    std::copy(
+        _nextWindowForwardMetrics.begin() + 1,
+        _nextWindowForwardMetrics.begin() + numWindows,
+        _windowForwardMetrics[decoder].begin() + 1);
+    std::copy(
+        _nextWindowBackwardMetrics.begin(),
+        _nextWindowBackwardMetrics.begin() + numWindows - 1,
+        _windowBackwardMetrics[decoder].begin());
+}
+
+// Every code block size is even, and so is every window, for the radix-4
+// kernel.
+static inline size_t getWindowStart(size_t blockSize, size_t window, size_t numWindows)
+{
+    return ((window * blockSize) / numWindows) & ~size_t(1);
+}
+
+inline void LTETurboMAPDecoder::_setLLR(size_t step, int llr, int systematic, int apriori)
+{
+    const int extrinsic = ((llr - systematic - apriori) * _extrinsicScaleFixed) >> ExtrinsicScaleBits;
+
+    _llrs[step] = static_cast<std::int16_t>(llr);
+    _extrinsic[step] = static_cast<std::int16_t>(std::max<int>(-ExtrinsicLimit, std::min<int>(ExtrinsicLimit, extrinsic)));
+}
+
+template <bool IsLogMAP>
+void LTETurboMAPDecoder::_decodeWindow(size_t decoder, size_t window, size_t numWindows)
+{
+    const size_t K = _blockSize;
+    const size_t start = getWindowStart(K, window, numWindows);
+    const size_t end = getWindowStart(K, window + 1, numWindows);
+
+    const auto* systematic = _systematic[decoder].data();
+    const auto* parity = _parity[decoder].data();
+    const auto* apriori = _apriori[decoder].data();
+
+    const Int16x8 zeros = {0};
+
+    Int16x8 forwardMetrics = _windowForwardMetrics[decoder][window];
+    for(size_t step = start; step < end; ++step)
+    {
+        _forwardMetrics[step] = forwardMetrics;
+
+        const Int16x8 systematicLLR = zeros + static_cast<std::int16_t>(systematic[step] + apriori[step]);
+        const Int16x8 parityLLR = zeros + parity[step];
+
+        const Int16x8 metric0 = getEvenPredecessors(forwardMetrics)
+                              + (_forwardSystematicMasks[0] & systematicLLR)
+                              + (_forwardParityMasks[0] & parityLLR);
+        const Int16x8 metric1 = getOddPredecessors(forwardMetrics)
+                              + (_forwardSystematicMasks[1] & systematicLLR)
+                              + (_forwardParityMasks[1] & parityLLR);
+
+        forwardMetrics = maxOf<IsLogMAP>(metric0, metric1);
+        forwardMetrics -= (zeros + forwardMetrics[0]);
+    }
+    if((window + 1) < numWindows) _nextWindowForwardMetrics[window + 1] = forwardMetrics;
+
+    Int16x8 backwardMetrics = _windowBackwardMetrics[decoder][window];
+    for(size_t step = end; step-- > start;)
+    {
+        const Int16x8 systematicLLR = zeros + static_cast<std::int16_t>(systematic[step] + apriori[step]);
+        const Int16x8 parityLLR = zeros + parity[step];
+
+        const Int16x8 metric0 = getFirstSuccessors(backwardMetrics)
+                              + (_backwardSystematicMasks[0] & systematicLLR)
+                              + (_backwardParityMasks[0] & parityLLR);
+        const Int16x8 metric1 = getSecondSuccessors(backwardMetrics)
+                              + (_backwardSystematicMasks[1] & systematicLLR)
+                              + (_backwardParityMasks[1] & parityLLR);
+
+        // Each state's input bit is 1 on exactly one of its two
+        // transitions.
+        const Int16x8 pathMetric0 = _forwardMetrics[step] + metric0;
+        const Int16x8 pathMetric1 = _forwardMetrics[step] + metric1;
+        const Int16x8 onePaths = _backwardSystematicMasks[0] ? pathMetric0 : pathMetric1;
+        const Int16x8 zeroPaths = _backwardSystematicMasks[0] ? pathMetric1 : pathMetric0;
+
+        const int llr = horizontalMax<IsLogMAP>(onePaths) - horizontalMax<IsLogMAP>(zeroPaths);
+        this->_setLLR(step, llr, systematic[step], apriori[step]);
+
+        backwardMetrics = maxOf<IsLogMAP>(metric0, metric1);
+        backwardMetrics -= (zeros + backwardMetrics[0]);
+    }
+    if(window > 0) _nextWindowBackwardMetrics[window - 1] = backwardMetrics;
+}
+
+template <bool IsLogMAP>
+void LTETurboMAPDecoder::_decodeWindowRadix4(size_t decoder, size_t window, size_t numWindows)
+{
+    const size_t K = _blockSize;
+    const size_t start = getWindowStart(K, window, numWindows);
+    const size_t end = getWindowStart(K, window + 1, numWindows);
+
+    const auto* systematic = _systematic[decoder].data();
+    const auto* parity = _parity[decoder].data();
+    const auto* apriori = _apriori[decoder].data();
+
+    const Int16x8 zeros = {0};
+
+    // Each step's radix-2 branch metrics, for both transitions into (forward)
+    // or out of (backward) each state
+    const auto getBranchMetrics = [&](size_t step, const Int16x8* systematicMasks, const Int16x8* parityMasks, Int16x8* branchMetrics)
+    {
+        const Int16x8 systematicLLR = zeros + static_cast<std::int16_t>(systematic[step] + apriori[step]);
+        const Int16x8 parityLLR = zeros + parity[step];
+
+        for(size_t i = 0; i < 2; ++i)
+        {
+            branchMetrics[i] = (systematicMasks[i] & systematicLLR) + (parityMasks[i] & parityLLR);
+        }
+    };
+
+    Int16x8 firstBranchMetrics[2];
+    Int16x8 secondBranchMetrics[2];
+
+    Int16x8 forwardMetrics = _windowForwardMetrics[decoder][window];
+    for(size_t step = start; step < end; step += 2)
+    {
+        _forwardMetrics[step] = forwardMetrics;
+
+        getBranchMetrics(step, _forwardSystematicMasks, _forwardParityMasks, firstBranchMetrics);
+        getBranchMetrics(step + 1, _forwardSystematicMasks, _forwardParityMasks, secondBranchMetrics);
+
+        // The middle state of predecessor j is an even or odd predecessor
+        // for j < 2 or j >= 2.
+        const Int16x8 metric0 = getRadix4Predecessors<0>(forwardMetrics) + getEvenPredecessors(firstBranchMetrics[0]) + secondBranchMetrics[0];
+        const Int16x8 metric1 = getRadix4Predecessors<1>(forwardMetrics) + getEvenPredecessors(firstBranchMetrics[1]) + secondBranchMetrics[0];
+        const Int16x8 metric2 = getRadix4Predecessors<2>(forwardMetrics) + getOddPredecessors(firstBranchMetrics[0]) + secondBranchMetrics[1];
+        const Int16x8 metric3 = getRadix4Predecessors<3>(forwardMetrics) + getOddPredecessors(firstBranchMetrics[1]) + secondBranchMetrics[1];
+
+        // The middle step's metrics are only needed for its LLRs, so they
+        // aren't part of the chain.
+        _forwardMetrics[step + 1] = maxOf<IsLogMAP>(
+            getEvenPredecessors(forwardMetrics) + firstBranchMetrics[0],
+            getOddPredecessors(forwardMetrics) + firstBranchMetrics[1]);
+
+        forwardMetrics = maxOf<IsLogMAP>(maxOf<IsLogMAP>(metric0, metric1), maxOf<IsLogMAP>(metric2, metric3));
+        forwardMetrics -= (zeros + forwardMetrics[0]);
+    }
+    if((window + 1) < numWindows) _nextWindowForwardMetrics[window + 1] = forwardMetrics;
+
+    Int16x8 backwardMetrics = _windowBackwardMetrics[decoder][window];
+    for(size_t step = end; step > start;)
+    {
+        step -= 2;
+
+        getBranchMetrics(step, _backwardSystematicMasks, _backwardParityMasks, firstBranchMetrics);
+        getBranchMetrics(step + 1, _backwardSystematicMasks, _backwardParityMasks, secondBranchMetrics);
+
+        // The middle state of successor j is a first or second successor
+        // for even or odd j.
+        const Int16x8 metrics[4] =
+        {
+            getRadix4Successors<0>(backwardMetrics) + firstBranchMetrics[0] + getFirstSuccessors(secondBranchMetrics[0]),
+            getRadix4Successors<1>(backwardMetrics) + firstBranchMetrics[1] + getSecondSuccessors(secondBranchMetrics[0]),
+            getRadix4Successors<2>(backwardMetrics) + firstBranchMetrics[0] + getFirstSuccessors(secondBranchMetrics[1]),
+            getRadix4Successors<3>(backwardMetrics) + firstBranchMetrics[1] + getSecondSuccessors(secondBranchMetrics[1]),
+        };
+
+        const Int16x8 pathMetrics[4] =
+        {
+            _forwardMetrics[step] + metrics[0],
+            _forwardMetrics[step] + metrics[1],
+            _forwardMetrics[step] + metrics[2],
+            _forwardMetrics[step] + metrics[3],
+        };
+
+        // Each state's input bit is 1 on exactly one of its two
+        // transitions, and paths 0 and 2, and 1 and 3, share the first.
+        const Int16x8& masks = _backwardSystematicMasks[0];
+
+        const Int16x8 firstOnePaths = maxOf<IsLogMAP>(
+            masks ? pathMetrics[0] : pathMetrics[1],
+            masks ? pathMetrics[2] : pathMetrics[3]);
+        const Int16x8 firstZeroPaths = maxOf<IsLogMAP>(
+            masks ? pathMetrics[1] : pathMetrics[0],
+            masks ? pathMetrics[3] : pathMetrics[2]);
+
+        // The second step's paths start from the middle states, like a
+        // radix-2 step.
+        const Int16x8 secondPathMetric0 = _forwardMetrics[step + 1] + getFirstSuccessors(backwardMetrics) + secondBranchMetrics[0];
+        const Int16x8 secondPathMetric1 = _forwardMetrics[step + 1] + getSecondSuccessors(backwardMetrics) + secondBranchMetrics[1];
+        const Int16x8 secondOnePaths = masks ? secondPathMetric0 : secondPathMetric1;
+        const Int16x8 secondZeroPaths = masks ? secondPathMetric1 : secondPathMetric0;
+
+        const int llrs[2] =
+        {
+            horizontalMax<IsLogMAP>(firstOnePaths) - horizontalMax<IsLogMAP>(firstZeroPaths),
+            horizontalMax<IsLogMAP>(secondOnePaths) - horizontalMax<IsLogMAP>(secondZeroPaths)
+        };
+        for(size_t i = 0; i < 2; ++i)
+        {
+            this->_setLLR(step + i, llrs[i], systematic[step + i], apriori[step + i]);
+        }
+
+        backwardMetrics = maxOf<IsLogMAP>(maxOf<IsLogMAP>(metrics[0], metrics[2]), maxOf<IsLogMAP>(metrics[1], metrics[3]));
+        backwardMetrics -= (zeros + backwardMetrics[0]);
+    }
+    if(window > 0) _nextWindowBackwardMetrics[window - 1] = backwardMetrics;
+}
+
+bool LTETurboMAPDecoder::_isDone(const std::uint8_t* output, size_t iteration)
+{
+    const size_t K = _blockSize;
+
+    switch(_earlyTermination)
+    {
+        case LTETurboEarlyTermination::CRC24A:
+            return (0 == calcLTECRC24A(output, K));
+
+        case LTETurboEarlyTermination::CRC24B:
+            return (0 == calcLTECRC24B(output, K));
+
+        case LTETurboEarlyTermination::Convergence:
+        {
+            const bool isConverged = (iteration > 1) && std::equal(output, output + K, _lastOutput.begin());
+            std::copy(output, output + K, _lastOutput.begin());
+
+            return isConverged;
+        }
+
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,196 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "VectorTypes.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// When LTETurboMAPDecoder stops iterating before its maximum
+enum class LTETurboEarlyTermination
+{
+    None,
+
+    // The code block is a whole transport block, whose CRC24A checks out.
+    CRC24A,
+
+    // The code block is one segment of a transport block, whose CRC24B
+    // checks out.
+    CRC24B,
+
+    // An iteration makes the same hard decisions as the last one.
+    Convergence
+};
+
+// Throws Pothos::InvalidArgumentException for unknown names.
+LTETurboEarlyTermination getLTETurboEarlyTermination(const std::string& name);
+
+// How LTETurboMAPDecoder combines the metrics of paths through the trellis
+enum class LTETurboAlgorithm
+{
+    // Only the best path counts, as in TurboFEC's decoder.
+    MaxLogMAP,
+
+    // Max-log-MAP overestimates its extrinsic LLRs, so scaling them down
+    // before they're passed to the other decoder usually saves an
+    // iteration, at almost no cost.
+    ScaledMaxLogMAP,
+
+    // Every path counts, using a table for the correction to max-log-MAP.
+    // Gains a fraction of a dB over max-log-MAP, at a few more operations
+    // per path. The table assumes soft bits are LLRs with 8 steps per nat.
+    LogMAP
+};
+
+static constexpr double DefaultLTETurboExtrinsicScale = 0.75;
+
+// Throws Pothos::InvalidArgumentException for unknown names.
+LTETurboAlgorithm getLTETurboAlgorithm(const std::string& name);
+
+// An LTE turbo decoder (TS 36.212 section 5.1.3.2), where each constituent
+// decoder uses the max-log approximation of the BCJR algorithm. Unlike
+// TurboFEC's decoder, which always runs every iteration, this can stop as
+// soon as a code block checks out, which at useful SNRs is usually after
+// one or two iterations.
+//
+// The 8 trellis states are vectorized across SIMD lanes. The trellis can
+// also be split into windows, decoded in parallel on the worker pool, to
+// cut the latency of large code blocks. All memory is allocated on
+// construction, for the largest code block.
+class LTETurboMAPDecoder
+{
+public:
+    using UPtr = std::unique_ptr<LTETurboMAPDecoder>;
+
+    LTETurboMAPDecoder();
+
+    inline LTETurboEarlyTermination earlyTermination() const
+    {
+        return _earlyTermination;
+    }
+
+    inline void setEarlyTermination(LTETurboEarlyTermination earlyTermination)
+    {
+        _earlyTermination = earlyTermination;
+    }
+
+    inline LTETurboAlgorithm algorithm() const
+    {
+        return _algorithm;
+    }
+
+    inline void setAlgorithm(LTETurboAlgorithm algorithm)
+    {
+        _algorithm = algorithm;
+    }
+
+    // Only used by LTETurboAlgorithm::ScaledMaxLogMAP
+    inline double extrinsicScale() const
+    {
+        return _extrinsicScale;
+    }
+
+    // Throws Pothos::InvalidArgumentException outside of (0, 1].
+    void setExtrinsicScale(double extrinsicScale);
+
+    inline size_t radix() const
+    {
+        return _radix;
+    }
+
+    // A radix of 4 takes two trellis steps at once, which halves the
+    // recursions' serial latency, with the same results as 2. Throws
+    // Pothos::InvalidArgumentException for anything else.
+    void setRadix(size_t radix);
+
+    inline size_t numWindows() const
+    {
+        return _numWindows;
+    }
+
+    // Windows are never shorter than 64 steps, so smaller code blocks
+    // use fewer. Throws Pothos::InvalidArgumentException for 0.
+    void setNumWindows(size_t numWindows);
+
+    // Decodes a code block of blockSize bits from the blockSize+4 soft bits
+    // of each of the encoder's three output streams, where positive values
+    // correspond to 1, into blockSize unpacked bits. Runs at most
+    // maxIterations iterations, and returns how many were run.
+    //
+    // If llrs isn't null, it's filled with the last iteration's blockSize
+    // a posteriori LLRs, in the same units and with the same sign as the
+    // soft bits.
+    size_t decode(
+        size_t blockSize,
+        size_t maxIterations,
+        const std::int8_t* d0,
+        const std::int8_t* d1,
+        const std::int8_t* d2,
+        std::uint8_t* output,
+        std::int16_t* llrs);
+
+private:
+    LTETurboEarlyTermination _earlyTermination;
+    size_t _numWindows;
+    size_t _radix;
+    LTETurboAlgorithm _algorithm;
+    double _extrinsicScale;
+
+    // The extrinsic scale for this decode, in fixed point
+    int _extrinsicScaleFixed;
+
+    size_t _blockSize;
+    std::vector<std::uint16_t> _interleaver;
+
+    // The transitions into (forward) and out of (backward) each state,
+    // for each of a state's two predecessors or successors. The masks are
+    // all ones in the lanes where the transition's systematic or parity
+    // bit is 1.
+    Int16x8 _forwardSystematicMasks[2];
+    Int16x8 _forwardParityMasks[2];
+    Int16x8 _backwardSystematicMasks[2];
+    Int16x8 _backwardParityMasks[2];
+
+    // Each constituent decoder's systematic and parity LLRs, including the
+    // three tail steps
+    std::vector<std::int16_t> _systematic[2];
+    std::vector<std::int16_t> _parity[2];
+
+    // Each constituent decoder's a priori LLRs, which are the other's
+    // extrinsic LLRs in its own bit order
+    std::vector<std::int16_t> _apriori[2];
+
+    std::vector<std::int16_t> _extrinsic;
+    std::vector<std::int16_t> _llrs;
+
+    // The forward metrics at the start of each step
+    AlignedArray<Int16x8> _forwardMetrics;
+
+    // For each constituent decoder, each window's forward metrics at its
+    // start and backward metrics at its end, which the windows fill in
+    // for their neighbors to start from in the next iteration
+    AlignedArray<Int16x8> _windowForwardMetrics[2];
+    AlignedArray<Int16x8> _windowBackwardMetrics[2];
+    AlignedArray<Int16x8> _nextWindowForwardMetrics;
+    AlignedArray<Int16x8> _nextWindowBackwardMetrics;
+
+    std::vector<std::uint8_t> _lastOutput;
+
+    void _setBlockSize(size_t blockSize);
+
+    void _decodeConstituent(size_t decoder);
+
+    template <bool IsLogMAP>
+    void _decodeWindow(size_t decoder, size_t window, size_t numWindows);
+
+    template <bool IsLogMAP>
+    void _decodeWindowRadix4(size_t decoder, size_t window, size_t numWindows);
+
+    void _setLLR(size_t step, int llr, int systematic, int apriori);
+
+    bool _isDone(const std::uint8_t* output, size_t iteration);
+};
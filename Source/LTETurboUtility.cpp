@@ -0,0 +1,323 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "LTETurboUtility.hpp"
+
+#include <Pothos/Exception.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string>
+
+// The generator polynomials, without the x^24 term
+static constexpr std::uint32_t CRC24APoly = 0x864CFB;
+static constexpr std::uint32_t CRC24BPoly = 0x800063;
+static constexpr std::uint32_t CRC24Mask = 0xFFFFFF;
+
+using CRCTable = std::array<std::uint32_t, 256>;
+
+static CRCTable makeCRCTable(std::uint32_t poly)
+{
+    CRCTable table;
+    for(std::uint32_t byte = 0; byte < table.size(); ++byte)
+    {
+        std::uint32_t crc = byte << 16;
+        for(int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc & 0x800000) ? ((crc << 1) ^ poly) : (crc << 1);
+        }
+        table[byte] = crc & CRC24Mask;
+    }
+
+    return table;
+}
+
+// Transport blocks are up to tens of thousands of bits, so this packs
+// them into bytes as it goes, for a table lookup per eight bits.
+static std::uint32_t calcCRC24(
+    const CRCTable& table,
+    std::uint32_t poly,
+    const std::uint8_t* bits,
+    size_t numBits)
+{
+    std::uint32_t crc = 0;
+
+    size_t index = 0;
+    for(; (index + 8) <= numBits; index += 8)
+    {
+        std::uint32_t byte = 0;
+        for(size_t bit = 0; bit < 8; ++bit) byte = (byte << 1) | (bits[index + bit] & 1);
+
+        crc = ((crc << 8) ^ table[((crc >> 16) ^ byte) & 0xFF]) & CRC24Mask;
+    }
+    for(; index < numBits; ++index)
+    {
+        const bool feedback = ((crc >> 23) ^ bits[index]) & 1;
+        crc = (crc << 1) & CRC24Mask;
+        if(feedback) crc ^= poly;
+    }
+
+    return crc;
+}
+
+std::uint32_t calcLTECRC24A(const std::uint8_t* bits, size_t numBits)
+{
+    static const auto table = makeCRCTable(CRC24APoly);
+
+    return calcCRC24(table, CRC24APoly, bits, numBits);
+}
+
+std::uint32_t calcLTECRC24B(const std::uint8_t* bits, size_t numBits)
+{
+    static const auto table = makeCRCTable(CRC24BPoly);
+
+    return calcCRC24(table, CRC24BPoly, bits, numBits);
+}
+
+void writeLTECRC(std::uint32_t crc, std::uint8_t* output)
+{
+    for(size_t bit = 0; bit < LTECRCLength; ++bit)
+    {
+        output[bit] = (crc >> (LTECRCLength - 1 - bit)) & 1;
+    }
+}
+
+// The block sizes in table 5.1.3-3 step by 8 up to 512 bits, and the step
+// doubles at each power of two after that.
+static size_t getBlockSizeStep(size_t blockSize)
+{
+    if(blockSize <= 512)  return 8;
+    if(blockSize <= 1024) return 16;
+    if(blockSize <= 2048) return 32;
+
+    return 64;
+}
+
+bool isLTETurboBlockSize(size_t blockSize)
+{
+    return (blockSize >= 40) &&
+           (blockSize <= LTEMaxCodeBlockSize) &&
+           (0 == (blockSize % getBlockSizeStep(blockSize)));
+}
+
+// The smallest valid block size of at least the given size
+static size_t roundUpToBlockSize(size_t size)
+{
+    if(size <= 40) return 40;
+
+    const auto step = getBlockSizeStep(size);
+
+    return ((size + step - 1) / step) * step;
+}
+
+// The largest valid block size smaller than the given valid size
+static size_t getPreviousBlockSize(size_t blockSize)
+{
+    return blockSize - getBlockSizeStep(blockSize - 1);
+}
+
+// The quadratic permutation polynomial interleaver's parameters for each
+// block size, from table 5.1.3-3
+struct QPPParams
+{
+    std::uint16_t blockSize;
+    std::uint16_t f1;
+    std::uint16_t f2;
+};
+
+static const QPPParams QPPTable[] =
+{
+    {40, 3, 10}, {48, 7, 12}, {56, 19, 42}, {64, 7, 16},
+    {72, 7, 18}, {80, 11, 20}, {88, 5, 22}, {96, 11, 24},
+    {104, 7, 26}, {112, 41, 84}, {120, 103, 90}, {128, 15, 32},
+    {136, 9, 34}, {144, 17, 108}, {152, 9, 38}, {160, 21, 120},
+    {168, 101, 84}, {176, 21, 44}, {184, 57, 46}, {192, 23, 48},
+    {200, 13, 50}, {208, 27, 52}, {216, 11, 36}, {224, 27, 56},
+    {232, 85, 58}, {240, 29, 60}, {248, 33, 62}, {256, 15, 32},
+    {264, 17, 198}, {272, 33, 68}, {280, 103, 210}, {288, 19, 36},
+    {296, 19, 74}, {304, 37, 76}, {312, 19, 78}, {320, 21, 120},
+    {328, 21, 82}, {336, 115, 84}, {344, 193, 86}, {352, 21, 44},
+    {360, 133, 90}, {368, 81, 46}, {376, 45, 94}, {384, 23, 48},
+    {392, 243, 98}, {400, 151, 40}, {408, 155, 102}, {416, 25, 52},
+    {424, 51, 106}, {432, 47, 72}, {440, 91, 110}, {448, 29, 168},
+    {456, 29, 114}, {464, 247, 58}, {472, 29, 118}, {480, 89, 180},
+    {488, 91, 122}, {496, 157, 62}, {504, 55, 84}, {512, 31, 64},
+    {528, 17, 66}, {544, 35, 68}, {560, 227, 420}, {576, 65, 96},
+    {592, 19, 74}, {608, 37, 76}, {624, 41, 234}, {640, 39, 80},
+    {656, 185, 82}, {672, 43, 252}, {688, 21, 86}, {704, 155, 44},
+    {720, 79, 120}, {736, 139, 92}, {752, 23, 94}, {768, 217, 48},
+    {784, 25, 98}, {800, 17, 80}, {816, 127, 102}, {832, 25, 52},
+    {848, 239, 106}, {864, 17, 48}, {880, 137, 110}, {896, 215, 112},
+    {912, 29, 114}, {928, 15, 58}, {944, 147, 118}, {960, 29, 60},
+    {976, 59, 122}, {992, 65, 124}, {1008, 55, 84}, {1024, 31, 64},
+    {1056, 17, 66}, {1088, 171, 204}, {1120, 67, 140}, {1152, 35, 72},
+    {1184, 19, 74}, {1216, 39, 76}, {1248, 19, 78}, {1280, 199, 240},
+    {1312, 21, 82}, {1344, 211, 252}, {1376, 21, 86}, {1408, 43, 88},
+    {1440, 149, 60}, {1472, 45, 92}, {1504, 49, 846}, {1536, 71, 48},
+    {1568, 13, 28}, {1600, 17, 80}, {1632, 25, 102}, {1664, 183, 104},
+    {1696, 55, 954}, {1728, 127, 96}, {1760, 27, 110}, {1792, 29, 112},
+    {1824, 29, 114}, {1856, 57, 116}, {1888, 45, 354}, {1920, 31, 120},
+    {1952, 59, 610}, {1984, 185, 124}, {2016, 113, 420}, {2048, 31, 64},
+    {2112, 17, 66}, {2176, 171, 136}, {2240, 209, 420}, {2304, 253, 216},
+    {2368, 367, 444}, {2432, 265, 456}, {2496, 181, 468}, {2560, 39, 80},
+    {2624, 27, 164}, {2688, 127, 504}, {2752, 143, 172}, {2816, 43, 88},
+    {2880, 29, 300}, {2944, 45, 92}, {3008, 157, 188}, {3072, 47, 96},
+    {3136, 13, 28}, {3200, 111, 240}, {3264, 443, 204}, {3328, 51, 104},
+    {3392, 51, 212}, {3456, 451, 192}, {3520, 257, 220}, {3584, 57, 336},
+    {3648, 313, 228}, {3712, 271, 232}, {3776, 179, 236}, {3840, 331, 120},
+    {3904, 363, 244}, {3968, 375, 248}, {4032, 127, 168}, {4096, 31, 64},
+    {4160, 33, 130}, {4224, 43, 264}, {4288, 33, 134}, {4352, 477, 408},
+    {4416, 35, 138}, {4480, 233, 280}, {4544, 357, 142}, {4608, 337, 480},
+    {4672, 37, 146}, {4736, 71, 444}, {4800, 71, 120}, {4864, 37, 152},
+    {4928, 39, 462}, {4992, 127, 234}, {5056, 39, 158}, {5120, 39, 80},
+    {5184, 31, 96}, {5248, 113, 902}, {5312, 41, 166}, {5376, 251, 336},
+    {5440, 43, 170}, {5504, 21, 86}, {5568, 43, 174}, {5632, 45, 176},
+    {5696, 45, 178}, {5760, 161, 120}, {5824, 89, 182}, {5888, 323, 184},
+    {5952, 47, 186}, {6016, 23, 94}, {6080, 47, 190}, {6144, 263, 480},
+};
+
+std::vector<std::uint16_t> getLTETurboInterleaver(size_t blockSize)
+{
+    const auto* tableEnd = QPPTable + (sizeof(QPPTable) / sizeof(QPPTable[0]));
+    const auto* params = std::find_if(
+                             QPPTable,
+                             tableEnd,
+                             [blockSize](const QPPParams& entry)
+                             {
+                                 return (entry.blockSize == blockSize);
+                             });
+    if(tableEnd == params)
+    {
+        throw Pothos::InvalidArgumentException(
+                  "Invalid turbo code block size",
+                  std::to_string(blockSize));
+    }
+
+    // Pi(i) = (f1*i + f2*i^2) mod K, computed from the differences between
+    // consecutive terms so nothing overflows.
+    const std::uint32_t K = params->blockSize;
+    const std::uint32_t twoF2 = (2 * params->f2) % K;
+
+    std::vector<std::uint16_t> interleaver(K);
+    std::uint32_t index = 0;
+    std::uint32_t delta = (params->f1 + params->f2) % K;
+    for(std::uint32_t i = 0; i < K; ++i)
+    {
+        interleaver[i] = static_cast<std::uint16_t>(index);
+
+        index = (index + delta) % K;
+        delta = (delta + twoF2) % K;
+    }
+
+    return interleaver;
+}
+
+LTECodeBlockSegmentation calcLTECodeBlockSegmentation(size_t transportBlockSize)
+{
+    if(0 == transportBlockSize)
+    {
+        throw Pothos::InvalidArgumentException("Transport blocks cannot be empty");
+    }
+    if(transportBlockSize > LTEMaxTransportBlockSize)
+    {
+        throw Pothos::InvalidArgumentException("Max transport block size: " + std::to_string(LTEMaxTransportBlockSize));
+    }
+
+    LTECodeBlockSegmentation segmentation;
+    segmentation.transportBlockSize = transportBlockSize;
+
+    const size_t B = transportBlockSize + LTECRCLength;
+
+    // Bits per code block, including any code block CRCs (B' in the spec)
+    size_t totalSize = B;
+    if(B <= LTEMaxCodeBlockSize)
+    {
+        segmentation.numCodeBlocks = 1;
+    }
+    else
+    {
+        segmentation.numCodeBlocks = (B + (LTEMaxCodeBlockSize - LTECRCLength) - 1) / (LTEMaxCodeBlockSize - LTECRCLength);
+        totalSize += segmentation.numCodeBlocks * LTECRCLength;
+    }
+
+    const size_t C = segmentation.numCodeBlocks;
+    segmentation.largeBlockSize = roundUpToBlockSize((totalSize + C - 1) / C);
+
+    if(1 == C)
+    {
+        segmentation.numSmallBlocks = 0;
+        segmentation.smallBlockSize = 0;
+    }
+    else
+    {
+        segmentation.smallBlockSize = getPreviousBlockSize(segmentation.largeBlockSize);
+        segmentation.numSmallBlocks = ((C * segmentation.largeBlockSize) - totalSize) / (segmentation.largeBlockSize - segmentation.smallBlockSize);
+    }
+
+    segmentation.numFillerBits = segmentation.totalCodeBlockSize() - totalSize;
+
+    return segmentation;
+}
+
+void getLTECodeBlock(
+    const LTECodeBlockSegmentation& segmentation,
+    const std::uint8_t* transportBlockWithCRC,
+    size_t codeBlock,
+    std::uint8_t* output)
+{
+    const size_t blockSize = segmentation.codeBlockSize(codeBlock);
+    const size_t crcLength = segmentation.codeBlockCRCLength();
+
+    // Every code block before this one took its data bits, after the first
+    // one's filler bits.
+    const size_t fillerLength = (0 == codeBlock) ? segmentation.numFillerBits : 0;
+    const size_t dataStart = (0 == codeBlock)
+                           ? 0
+                           : (segmentation.codeBlockStart(codeBlock) - (codeBlock * crcLength) - segmentation.numFillerBits);
+    const size_t dataLength = blockSize - crcLength - fillerLength;
+
+    std::memset(output, 0, fillerLength);
+    std::memcpy(output + fillerLength, transportBlockWithCRC + dataStart, dataLength);
+
+    if(crcLength > 0)
+    {
+        writeLTECRC(calcLTECRC24B(output, blockSize - crcLength), output + blockSize - crcLength);
+    }
+}
+
+template <typename T>
+static void getLTETransportBlockImpl(
+    const LTECodeBlockSegmentation& segmentation,
+    const T* codeBlocks,
+    T* transportBlockWithCRC)
+{
+    const size_t crcLength = segmentation.codeBlockCRCLength();
+
+    T* output = transportBlockWithCRC;
+    for(size_t codeBlock = 0; codeBlock < segmentation.numCodeBlocks; ++codeBlock)
+    {
+        const size_t fillerLength = (0 == codeBlock) ? segmentation.numFillerBits : 0;
+        const size_t dataLength = segmentation.codeBlockSize(codeBlock) - crcLength - fillerLength;
+        const auto* input = codeBlocks + segmentation.codeBlockStart(codeBlock) + fillerLength;
+
+        std::memcpy(output, input, dataLength * sizeof(T));
+        output += dataLength;
+    }
+}
+
+void getLTETransportBlock(
+    const LTECodeBlockSegmentation& segmentation,
+    const std::uint8_t* codeBlocks,
+    std::uint8_t* transportBlockWithCRC)
+{
+    getLTETransportBlockImpl(segmentation, codeBlocks, transportBlockWithCRC);
+}
+
+void getLTETransportBlock(
+    const LTECodeBlockSegmentation& segmentation,
+    const std::int16_t* codeBlocks,
+    std::int16_t* transportBlockWithCRC)
+{
+    getLTETransportBlockImpl(segmentation, codeBlocks, transportBlockWithCRC);
+}
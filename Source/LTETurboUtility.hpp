@@ -0,0 +1,102 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//
+// Transport block processing from TS 36.212 sections 5.1.1 and 5.1.2.
+// All bits are unpacked, one per byte.
+//
+
+static constexpr size_t LTECRCLength = 24;
+
+// Code blocks larger than this are split.
+static constexpr size_t LTEMaxCodeBlockSize = 6144;
+
+// The largest transport block in TS 36.213's transport block size tables,
+// for four spatial layers
+static constexpr size_t LTEMaxTransportBlockSize = 391656;
+
+// The CRC attached to each transport block
+std::uint32_t calcLTECRC24A(const std::uint8_t* bits, size_t numBits);
+
+// The CRC attached to each code block of a segmented transport block
+std::uint32_t calcLTECRC24B(const std::uint8_t* bits, size_t numBits);
+
+// Writes the CRC's LTECRCLength bits, most significant first.
+void writeLTECRC(std::uint32_t crc, std::uint8_t* output);
+
+// Returns whether the turbo interleaver is defined for blocks of this size.
+bool isLTETurboBlockSize(size_t blockSize);
+
+// Returns the turbo interleaver for code blocks of the given size, where
+// element i is the index of the bit the second constituent encoder takes
+// at step i. Throws Pothos::InvalidArgumentException for invalid sizes.
+std::vector<std::uint16_t> getLTETurboInterleaver(size_t blockSize);
+
+// How a transport block and its CRC24A are split into code blocks. The
+// smaller code blocks come first, and filler bits, which are encoded as 0,
+// pad the start of the first.
+struct LTECodeBlockSegmentation
+{
+    size_t transportBlockSize;
+    size_t numCodeBlocks;
+    size_t numFillerBits;
+    size_t numSmallBlocks;
+    size_t smallBlockSize;
+    size_t largeBlockSize;
+
+    inline size_t codeBlockSize(size_t codeBlock) const
+    {
+        return (codeBlock < numSmallBlocks) ? smallBlockSize : largeBlockSize;
+    }
+
+    // Each code block only has its own CRC if there's more than one.
+    inline size_t codeBlockCRCLength() const
+    {
+        return (numCodeBlocks > 1) ? LTECRCLength : 0;
+    }
+
+    // Where the code block starts, in all of the code blocks back-to-back
+    inline size_t codeBlockStart(size_t codeBlock) const
+    {
+        return (codeBlock < numSmallBlocks)
+             ? (codeBlock * smallBlockSize)
+             : ((numSmallBlocks * smallBlockSize) + ((codeBlock - numSmallBlocks) * largeBlockSize));
+    }
+
+    inline size_t totalCodeBlockSize() const
+    {
+        return this->codeBlockStart(numCodeBlocks);
+    }
+};
+
+// Throws Pothos::InvalidArgumentException if the transport block is empty
+// or larger than LTEMaxTransportBlockSize.
+LTECodeBlockSegmentation calcLTECodeBlockSegmentation(size_t transportBlockSize);
+
+// Fills in the given code block from the transport block followed by its
+// CRC24A, including the filler bits and code block CRC.
+void getLTECodeBlock(
+    const LTECodeBlockSegmentation& segmentation,
+    const std::uint8_t* transportBlockWithCRC,
+    size_t codeBlock,
+    std::uint8_t* output);
+
+// The inverse of getLTECodeBlock, which fills in the transport block
+// followed by its CRC24A from all of the code blocks back-to-back, dropping
+// the filler bits and code block CRCs.
+void getLTETransportBlock(
+    const LTECodeBlockSegmentation& segmentation,
+    const std::uint8_t* codeBlocks,
+    std::uint8_t* transportBlockWithCRC);
+
+// The same, for per-bit soft values
+void getLTETransportBlock(
+    const LTECodeBlockSegmentation& segmentation,
+    const std::int16_t* codeBlocks,
+    std::int16_t* transportBlockWithCRC);
@@ -0,0 +1,123 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "LTETurboUtility.hpp"
+#include "LTETurboWorkspacePool.hpp"
+
+#include <Pothos/Exception.hpp>
+
+extern "C"
+{
+#include <turbofec/turbo.h>
+}
+
+#include <utility>
+
+//
+// LTETurboWorkspace
+//
+
+LTETurboWorkspace::LTETurboWorkspace():
+    _tDecoder(nullptr)
+{
+}
+
+LTETurboWorkspace::~LTETurboWorkspace()
+{
+    if(_tDecoder) ::free_tdec(_tDecoder);
+}
+
+struct tdecoder* LTETurboWorkspace::tDecoder()
+{
+    if(!_tDecoder)
+    {
+        _tDecoder = ::alloc_tdec();
+        if(!_tDecoder) throw Pothos::RuntimeException("Failed to allocate a TurboFEC decoder");
+    }
+
+    return _tDecoder;
+}
+
+LTETurboMAPDecoder& LTETurboWorkspace::mapDecoder()
+{
+    if(!_mapDecoderUPtr) _mapDecoderUPtr.reset(new LTETurboMAPDecoder);
+
+    return *_mapDecoderUPtr;
+}
+
+std::uint8_t* LTETurboWorkspace::decodedBits()
+{
+    _decodedBits.resize(LTEMaxCodeBlockSize);
+
+    return _decodedBits.data();
+}
+
+//
+// LTETurboWorkspacePool::Lease
+//
+
+LTETurboWorkspacePool::Lease::Lease(
+    LTETurboWorkspacePool& pool,
+    std::unique_ptr<LTETurboWorkspace>&& workspace
+):
+    _pool(pool),
+    _workspace(std::move(workspace))
+{
+}
+
+LTETurboWorkspacePool::Lease::~Lease()
+{
+    // A moved-from lease has nothing to return.
+    if(_workspace) _pool._checkIn(std::move(_workspace));
+}
+
+//
+// LTETurboWorkspacePool
+//
+
+LTETurboWorkspacePool& LTETurboWorkspacePool::global()
+{
+    static LTETurboWorkspacePool pool;
+
+    return pool;
+}
+
+LTETurboWorkspacePool::LTETurboWorkspacePool():
+    _numWorkspaces(0)
+{
+}
+
+LTETurboWorkspacePool::Lease LTETurboWorkspacePool::checkOut()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if(!_freeWorkspaces.empty())
+        {
+            auto workspace = std::move(_freeWorkspaces.back());
+            _freeWorkspaces.pop_back();
+
+            return Lease(*this, std::move(workspace));
+        }
+
+        ++_numWorkspaces;
+    }
+
+    // Allocate outside of the lock. The decoders themselves are only
+    // allocated once used.
+    return Lease(*this, std::unique_ptr<LTETurboWorkspace>(new LTETurboWorkspace));
+}
+
+size_t LTETurboWorkspacePool::numWorkspaces() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _numWorkspaces;
+}
+
+void LTETurboWorkspacePool::_checkIn(std::unique_ptr<LTETurboWorkspace>&& workspace)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _freeWorkspaces.emplace_back(std::move(workspace));
+}
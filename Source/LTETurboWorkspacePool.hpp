@@ -0,0 +1,97 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "LTETurboMAPDecoder.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct tdecoder;
+
+// Everything one thread needs to decode an LTE turbo code block. Each
+// decoder is only allocated the first time it's needed.
+class LTETurboWorkspace
+{
+public:
+    LTETurboWorkspace();
+
+    ~LTETurboWorkspace();
+
+    LTETurboWorkspace(const LTETurboWorkspace&) = delete;
+    LTETurboWorkspace& operator=(const LTETurboWorkspace&) = delete;
+
+    struct tdecoder* tDecoder();
+
+    LTETurboMAPDecoder& mapDecoder();
+
+    // Room for a code block's unpacked bits, for decoders that can't
+    // write packed bits themselves
+    std::uint8_t* decodedBits();
+
+private:
+    struct tdecoder* _tDecoder;
+    LTETurboMAPDecoder::UPtr _mapDecoderUPtr;
+    std::vector<std::uint8_t> _decodedBits;
+};
+
+// A process-wide pool of LTE turbo decoding workspaces. Each decoder's
+// state is sized for the largest code block, so rather than every block
+// holding its own, blocks check one out only for the duration of a decode.
+// The pool only grows to the most decodes ever run at once.
+//
+// The most recently checked in workspaces are checked out first, since
+// they're the likeliest to still be in cache.
+class LTETurboWorkspacePool
+{
+public:
+    static LTETurboWorkspacePool& global();
+
+    // Returns its workspace to the pool on destruction.
+    class Lease
+    {
+    public:
+        Lease(LTETurboWorkspacePool& pool, std::unique_ptr<LTETurboWorkspace>&& workspace);
+
+        ~Lease();
+
+        Lease(Lease&&) = default;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        inline LTETurboWorkspace& operator*() const
+        {
+            return *_workspace;
+        }
+
+        inline LTETurboWorkspace* operator->() const
+        {
+            return _workspace.get();
+        }
+
+    private:
+        LTETurboWorkspacePool& _pool;
+        std::unique_ptr<LTETurboWorkspace> _workspace;
+    };
+
+    LTETurboWorkspacePool();
+
+    LTETurboWorkspacePool(const LTETurboWorkspacePool&) = delete;
+    LTETurboWorkspacePool& operator=(const LTETurboWorkspacePool&) = delete;
+
+    Lease checkOut();
+
+    // How many workspaces have been allocated, checked out or not
+    size_t numWorkspaces() const;
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<LTETurboWorkspace>> _freeWorkspaces;
+    size_t _numWorkspaces;
+
+    void _checkIn(std::unique_ptr<LTETurboWorkspace>&& workspace);
+};
@@ -0,0 +1,217 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "MaxLogMAPConvDecoder.hpp"
+#include "ConvolutionUtility.hpp"
+
+#include <algorithm>
+#include <limits>
+
+static_assert(
+    (sizeof(Int16x16) / sizeof(std::int16_t)) == MaxLogMAPConvDecoder::NumLanes,
+    "Lane count must match the vector width");
+
+constexpr size_t MaxLogMAPConvDecoder::NumLanes;
+
+// As in MultiFrameViterbiDecoder, metrics are normalized against state 0
+// on every step, which keeps both recursions well within 16 bits. The sum
+// of a forward and backward metric may not be, so both are halved first.
+// This also puts the LLRs on the same scale as the input soft bits.
+static constexpr std::int16_t InvalidPathMetric = -16384;
+
+MaxLogMAPConvDecoder::MaxLogMAPConvDecoder(const ConvCodeConfig::SPtr& config):
+    _config(config),
+    _trellis(config->convCode()),
+    _length(static_cast<size_t>(config->convCode().len)),
+    _encodedLength(static_cast<size_t>(config->encodedLength())),
+    _isTailBiting(::CONV_TERM_TAIL_BITING == config->convCode().term),
+    _numSteps(_isTailBiting ? (_length * 2) : (_length + config->convCode().k - 1)),
+    _depunctureMap(getConvDepunctureMap(config->convCode(), config->convCode().len)),
+    _symbols(_depunctureMap.size()),
+    _branchMetrics(1U << _trellis.N()),
+    _forwardMetrics(_length * _trellis.numStates()),
+    _pathMetrics(_trellis.numStates()),
+    _nextPathMetrics(_trellis.numStates()),
+    _llrs(_length),
+    _decodeFcn(nullptr)
+{
+    switch(convCodeShape(_trellis.K(), _trellis.N()))
+    {
+        case convCodeShape(5, 2): _decodeFcn = &MaxLogMAPConvDecoder::_decode<5, 2>; break;
+        case convCodeShape(5, 3): _decodeFcn = &MaxLogMAPConvDecoder::_decode<5, 3>; break;
+        case convCodeShape(5, 4): _decodeFcn = &MaxLogMAPConvDecoder::_decode<5, 4>; break;
+        case convCodeShape(7, 2): _decodeFcn = &MaxLogMAPConvDecoder::_decode<7, 2>; break;
+        case convCodeShape(7, 3): _decodeFcn = &MaxLogMAPConvDecoder::_decode<7, 3>; break;
+        case convCodeShape(7, 4): _decodeFcn = &MaxLogMAPConvDecoder::_decode<7, 4>; break;
+        default:                  _decodeFcn = &MaxLogMAPConvDecoder::_decode<0, 0>; break;
+    }
+}
+
+void MaxLogMAPConvDecoder::decode(const std::int8_t* input, size_t numFrames, float* output)
+{
+    (this->*_decodeFcn)(input, numFrames);
+
+    for(size_t lane = 0; lane < numFrames; ++lane)
+    {
+        auto* laneOutput = output + (lane * _length);
+        for(size_t i = 0; i < _length; ++i)
+        {
+            laneOutput[i] = static_cast<float>(_llrs[i][lane]);
+        }
+    }
+}
+
+void MaxLogMAPConvDecoder::decode(const std::int8_t* input, size_t numFrames, std::int8_t* output)
+{
+    (this->*_decodeFcn)(input, numFrames);
+
+    for(size_t lane = 0; lane < numFrames; ++lane)
+    {
+        auto* laneOutput = output + (lane * _length);
+        for(size_t i = 0; i < _length; ++i)
+        {
+            const auto llr = _llrs[i][lane];
+            laneOutput[i] = static_cast<std::int8_t>(std::max<std::int32_t>(-127, std::min<std::int32_t>(127, llr)));
+        }
+    }
+}
+
+template <int FixedN>
+void MaxLogMAPConvDecoder::_calcBranchMetrics(size_t step)
+{
+    const int N = (FixedN > 0) ? FixedN : _trellis.N();
+    const unsigned numOutputs = 1U << N;
+    const size_t numSymbolSteps = _symbols.size() / static_cast<size_t>(N);
+    const auto* symbols = &_symbols[getSymbolStep(step, numSymbolSteps) * N];
+
+    const Int16x16 zeros = {0};
+
+    for(unsigned output = 0; output < numOutputs; ++output)
+    {
+        Int16x16 branchMetric = zeros;
+        for(int i = 0; i < N; ++i)
+        {
+            if((output >> i) & 1) branchMetric += symbols[i];
+            else                  branchMetric -= symbols[i];
+        }
+        _branchMetrics[output] = branchMetric;
+    }
+}
+
+template <int FixedK, int FixedN>
+void MaxLogMAPConvDecoder::_decode(const std::int8_t* input, size_t numFrames)
+{
+    const int K = (FixedK > 0) ? FixedK : _trellis.K();
+    const unsigned numStates = 1U << (K - 1);
+    const unsigned stateMask = numStates - 1;
+    const unsigned registerBitShift = static_cast<unsigned>(K - 2);
+
+    // Punctured bits carry no information, so they're treated as erasures,
+    // as are the lanes of any frames we weren't given.
+    for(size_t i = 0; i < _depunctureMap.size(); ++i)
+    {
+        auto& symbol = _symbols[i];
+        const int encodedIndex = _depunctureMap[i];
+
+        for(size_t lane = 0; lane < NumLanes; ++lane)
+        {
+            symbol[lane] = ((encodedIndex >= 0) && (lane < numFrames)) ? input[(lane * _encodedLength) + encodedIndex] : 0;
+        }
+    }
+
+    const Int16x16 zeros = {0};
+    const Int16x16 invalids = zeros + InvalidPathMetric;
+    const Int16x16 minMetrics = zeros + std::numeric_limits<std::int16_t>::min();
+
+    // Flushed frames output the bits before the tail, and tail-biting frames
+    // output the second pass, as the forward metrics have converged by then.
+    const size_t outputStart = _isTailBiting ? _length : 0;
+
+    //
+    // Forward recursion
+    //
+
+    for(auto& pathMetric: _pathMetrics) pathMetric = (_isTailBiting ? zeros : invalids);
+    _pathMetrics[0] = zeros;
+
+    for(size_t step = 0; step < _numSteps; ++step)
+    {
+        if((step >= outputStart) && (step < (outputStart + _length)))
+        {
+            std::copy(
+                _pathMetrics.begin(),
+                _pathMetrics.end(),
+                &_forwardMetrics[(step - outputStart) * numStates]);
+        }
+
+        this->_calcBranchMetrics<FixedN>(step);
+
+        for(unsigned state = 0; state < numStates; ++state)
+        {
+            const unsigned registerBit = state >> registerBitShift;
+            const unsigned prevState0 = (state << 1) & stateMask;
+            const unsigned prevState1 = prevState0 | 1;
+
+            const Int16x16 metric0 = _pathMetrics[prevState0] + _branchMetrics[_trellis.output(prevState0, registerBit)];
+            const Int16x16 metric1 = _pathMetrics[prevState1] + _branchMetrics[_trellis.output(prevState1, registerBit)];
+
+            _nextPathMetrics[state] = (metric1 > metric0) ? metric1 : metric0;
+        }
+
+        const Int16x16 normalization = _nextPathMetrics[0];
+        for(unsigned state = 0; state < numStates; ++state)
+        {
+            _pathMetrics[state] = _nextPathMetrics[state] - normalization;
+        }
+    }
+
+    //
+    // Backward recursion, combining both sets of metrics into LLRs over the
+    // first frame's worth of steps. For tail-biting frames, the second pass
+    // gives the backward metrics time to converge.
+    //
+
+    for(auto& pathMetric: _pathMetrics) pathMetric = (_isTailBiting ? zeros : invalids);
+    _pathMetrics[0] = zeros;
+
+    for(size_t step = _numSteps; step > 0; --step)
+    {
+        this->_calcBranchMetrics<FixedN>(step-1);
+
+        if((step-1) < _length)
+        {
+            const auto* forwardMetrics = &_forwardMetrics[(step-1) * numStates];
+
+            Int16x16 maxMetric0 = minMetrics;
+            Int16x16 maxMetric1 = minMetrics;
+
+            for(unsigned state = 0; state < numStates; ++state)
+            {
+                for(unsigned registerBit = 0; registerBit < 2; ++registerBit)
+                {
+                    const Int16x16 forwardMetric = forwardMetrics[state] + _branchMetrics[_trellis.output(state, registerBit)];
+                    const Int16x16 metric = (forwardMetric >> 1) + (_pathMetrics[_trellis.nextState(state, registerBit)] >> 1);
+
+                    auto& maxMetric = _trellis.inputBit(state, registerBit) ? maxMetric1 : maxMetric0;
+                    maxMetric = (metric > maxMetric) ? metric : maxMetric;
+                }
+            }
+
+            _llrs[step-1] = __builtin_convertvector(maxMetric1, Int32x16) - __builtin_convertvector(maxMetric0, Int32x16);
+        }
+
+        for(unsigned state = 0; state < numStates; ++state)
+        {
+            const Int16x16 metric0 = _pathMetrics[_trellis.nextState(state, 0)] + _branchMetrics[_trellis.output(state, 0)];
+            const Int16x16 metric1 = _pathMetrics[_trellis.nextState(state, 1)] + _branchMetrics[_trellis.output(state, 1)];
+
+            _nextPathMetrics[state] = (metric1 > metric0) ? metric1 : metric0;
+        }
+
+        const Int16x16 normalization = _nextPathMetrics[0];
+        for(unsigned state = 0; state < numStates; ++state)
+        {
+            _pathMetrics[state] = _nextPathMetrics[state] - normalization;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "ConvCodeConfig.hpp"
+#include "ConvTrellis.hpp"
+#include "VectorTypes.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A soft-output decoder using the max-log approximation of the BCJR
+// algorithm. Like MultiFrameViterbiDecoder, this decodes up to NumLanes
+// frames of the same code at once, one frame per SIMD lane.
+//
+// The sign of each output LLR matches the Viterbi decision, and its
+// magnitude is on the same scale as the input soft bits, where positive
+// values correspond to 1.
+class MaxLogMAPConvDecoder
+{
+public:
+    using UPtr = std::unique_ptr<MaxLogMAPConvDecoder>;
+
+    static constexpr size_t NumLanes = 16;
+
+    explicit MaxLogMAPConvDecoder(const ConvCodeConfig::SPtr& config);
+
+    inline const ConvCodeConfig::SPtr& config() const
+    {
+        return _config;
+    }
+
+    // Decodes numFrames (at most NumLanes) consecutive frames of
+    // config()->encodedLength() soft bits each into numFrames consecutive
+    // frames of config()->convCode().len LLRs.
+    void decode(const std::int8_t* input, size_t numFrames, float* output);
+
+    // As above, but saturating the LLRs to the range of the input.
+    void decode(const std::int8_t* input, size_t numFrames, std::int8_t* output);
+
+private:
+    using DecodeFcn = void(MaxLogMAPConvDecoder::*)(const std::int8_t*, size_t);
+
+    ConvCodeConfig::SPtr _config;
+    ConvTrellis _trellis;
+
+    size_t _length;
+    size_t _encodedLength;
+    bool _isTailBiting;
+    size_t _numSteps;
+
+    std::vector<int> _depunctureMap;
+
+    // Depunctured symbols, transposed so that each symbol holds that bit
+    // position for every frame.
+    AlignedArray<Int16x16> _symbols;
+
+    AlignedArray<Int16x16> _branchMetrics;
+
+    // The forward metrics at the start of each output step
+    AlignedArray<Int16x16> _forwardMetrics;
+
+    AlignedArray<Int16x16> _pathMetrics;
+    AlignedArray<Int16x16> _nextPathMetrics;
+
+    AlignedArray<Int32x16> _llrs;
+
+    // Instantiated for the standard codes' constraint lengths and rates
+    DecodeFcn _decodeFcn;
+
+    // FixedK and FixedN are 0 to read the code's shape at runtime.
+    template <int FixedK, int FixedN>
+    void _decode(const std::int8_t* input, size_t numFrames);
+
+    template <int FixedN>
+    void _calcBranchMetrics(size_t step);
+};
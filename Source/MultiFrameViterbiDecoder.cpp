@@ -0,0 +1,241 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "MultiFrameViterbiDecoder.hpp"
+#include "ConvolutionUtility.hpp"
+
+#include <Pothos/Exception.hpp>
+
+#include <algorithm>
+
+static_assert(
+    (sizeof(Int16x16) / sizeof(std::int16_t)) == MultiFrameViterbiDecoder::NumLanes,
+    "Lane count must match the vector width");
+
+constexpr size_t MultiFrameViterbiDecoder::NumLanes;
+
+// Path metrics are normalized against state 0 on every step, which bounds
+// the spread between states to well within 16 bits for int8 inputs. This
+// only needs to stay below any valid path until every state is reachable.
+static constexpr std::int16_t InvalidPathMetric = -16384;
+
+MultiFrameViterbiDecoder::MultiFrameViterbiDecoder(const ConvCodeConfig::SPtr& config):
+    _config(config),
+    _trellis(config->convCode()),
+    _length(static_cast<size_t>(config->convCode().len)),
+    _encodedLength(static_cast<size_t>(config->encodedLength())),
+    _isTailBiting(::CONV_TERM_TAIL_BITING == config->convCode().term),
+    _numSteps(_isTailBiting ? _length : (_length + config->convCode().k - 1)),
+    _maxTailBitingIterations(DefaultMaxTailBitingIterations),
+    _tailBitingStats(),
+    _depunctureMap(getConvDepunctureMap(config->convCode(), config->convCode().len)),
+    _symbols(_depunctureMap.size()),
+    _branchMetrics(1U << _trellis.N()),
+    _pathMetrics(_trellis.numStates()),
+    _nextPathMetrics(_trellis.numStates()),
+    _decisions(_numSteps * _trellis.numStates()),
+    _forwardFcn(nullptr)
+{
+    switch(convCodeShape(_trellis.K(), _trellis.N()))
+    {
+        case convCodeShape(5, 2): _forwardFcn = &MultiFrameViterbiDecoder::_forward<5, 2>; break;
+        case convCodeShape(5, 3): _forwardFcn = &MultiFrameViterbiDecoder::_forward<5, 3>; break;
+        case convCodeShape(5, 4): _forwardFcn = &MultiFrameViterbiDecoder::_forward<5, 4>; break;
+        case convCodeShape(7, 2): _forwardFcn = &MultiFrameViterbiDecoder::_forward<7, 2>; break;
+        case convCodeShape(7, 3): _forwardFcn = &MultiFrameViterbiDecoder::_forward<7, 3>; break;
+        case convCodeShape(7, 4): _forwardFcn = &MultiFrameViterbiDecoder::_forward<7, 4>; break;
+        default:                  _forwardFcn = &MultiFrameViterbiDecoder::_forward<0, 0>; break;
+    }
+}
+
+void MultiFrameViterbiDecoder::decode(const std::int8_t* input, std::uint8_t* output)
+{
+    this->_decode<false>(input, output);
+}
+
+void MultiFrameViterbiDecoder::decodePacked(const std::int8_t* input, std::uint8_t* output)
+{
+    this->_decode<true>(input, output);
+}
+
+void MultiFrameViterbiDecoder::setMaxTailBitingIterations(size_t maxTailBitingIterations)
+{
+    if(0 == maxTailBitingIterations)
+    {
+        throw Pothos::InvalidArgumentException("The maximum tail-biting iterations must be positive");
+    }
+
+    _maxTailBitingIterations = maxTailBitingIterations;
+}
+
+TailBitingStats MultiFrameViterbiDecoder::takeTailBitingStats()
+{
+    const auto stats = _tailBitingStats;
+    _tailBitingStats = TailBitingStats();
+
+    return stats;
+}
+
+template <bool Packed>
+void MultiFrameViterbiDecoder::_decode(const std::int8_t* input, std::uint8_t* output)
+{
+    // Punctured bits carry no information, so they're treated as erasures.
+    for(size_t i = 0; i < _depunctureMap.size(); ++i)
+    {
+        auto& symbol = _symbols[i];
+        const int encodedIndex = _depunctureMap[i];
+
+        for(size_t lane = 0; lane < NumLanes; ++lane)
+        {
+            symbol[lane] = (encodedIndex >= 0) ? input[(lane * _encodedLength) + encodedIndex] : 0;
+        }
+    }
+
+    const size_t outputFrameSize = Packed ? ((_length + 7) / 8) : _length;
+
+    // Flushed frames end in the zero state.
+    if(!_isTailBiting)
+    {
+        (this->*_forwardFcn)(true);
+        for(size_t lane = 0; lane < NumLanes; ++lane)
+        {
+            this->_traceback<Packed>(lane, 0, output + (lane * outputFrameSize));
+        }
+        return;
+    }
+
+    // A frame that has converged keeps its output from that pass, while
+    // the others are traced again after the next one.
+    std::uint16_t doneLanes = 0;
+    const std::uint16_t allLanes = (1U << NumLanes) - 1;
+
+    size_t iteration = 0;
+    while((allLanes != doneLanes) && (iteration < _maxTailBitingIterations))
+    {
+        (this->*_forwardFcn)(0 == iteration);
+        ++iteration;
+
+        for(size_t lane = 0; lane < NumLanes; ++lane)
+        {
+            if(doneLanes & (1U << lane)) continue;
+
+            const unsigned endState = this->_bestState(lane);
+            if(endState == this->_traceback<Packed>(lane, endState, output + (lane * outputFrameSize)))
+            {
+                doneLanes |= (1U << lane);
+
+                ++_tailBitingStats.numStateMatches;
+                _tailBitingStats.numIterations += iteration;
+            }
+        }
+    }
+
+    for(size_t lane = 0; lane < NumLanes; ++lane)
+    {
+        if(0 == (doneLanes & (1U << lane))) _tailBitingStats.numIterations += iteration;
+    }
+    _tailBitingStats.numFrames += NumLanes;
+}
+
+template <int FixedK, int FixedN>
+void MultiFrameViterbiDecoder::_forward(bool isFirstPass)
+{
+    const int K = (FixedK > 0) ? FixedK : _trellis.K();
+    const int N = (FixedN > 0) ? FixedN : _trellis.N();
+    const unsigned numStates = 1U << (K - 1);
+    const unsigned numOutputs = 1U << N;
+    const unsigned stateMask = numStates - 1;
+    const unsigned registerBitShift = static_cast<unsigned>(K - 2);
+
+    const Int16x16 zeros = {0};
+    const Int16x16 invalids = zeros + InvalidPathMetric;
+
+    // Flushed frames start in the zero state. Tail-biting frames can start
+    // in any state, so all states start out equally likely, and later
+    // passes wrap around from the last one's metrics, which are already
+    // normalized.
+    if(isFirstPass)
+    {
+        for(auto& pathMetric: _pathMetrics) pathMetric = (_isTailBiting ? zeros : invalids);
+        _pathMetrics[0] = zeros;
+    }
+
+    for(size_t step = 0; step < _numSteps; ++step)
+    {
+        const auto* symbols = &_symbols[step * N];
+
+        for(unsigned output = 0; output < numOutputs; ++output)
+        {
+            Int16x16 branchMetric = zeros;
+            for(int i = 0; i < N; ++i)
+            {
+                if((output >> i) & 1) branchMetric += symbols[i];
+                else                  branchMetric -= symbols[i];
+            }
+            _branchMetrics[output] = branchMetric;
+        }
+
+        auto* decisions = &_decisions[step * numStates];
+
+        for(unsigned state = 0; state < numStates; ++state)
+        {
+            const unsigned registerBit = state >> registerBitShift;
+            const unsigned prevState0 = (state << 1) & stateMask;
+            const unsigned prevState1 = prevState0 | 1;
+
+            const Int16x16 metric0 = _pathMetrics[prevState0] + _branchMetrics[_trellis.output(prevState0, registerBit)];
+            const Int16x16 metric1 = _pathMetrics[prevState1] + _branchMetrics[_trellis.output(prevState1, registerBit)];
+
+            // Each lane is all ones where the second predecessor won.
+            const Int16x16 decision = (metric1 > metric0);
+
+            decisions[state] = __builtin_convertvector(decision, Int8x16);
+            _nextPathMetrics[state] = decision ? metric1 : metric0;
+        }
+
+        const Int16x16 normalization = _nextPathMetrics[0];
+        for(unsigned state = 0; state < numStates; ++state)
+        {
+            _pathMetrics[state] = _nextPathMetrics[state] - normalization;
+        }
+    }
+}
+
+unsigned MultiFrameViterbiDecoder::_bestState(size_t lane) const
+{
+    unsigned bestState = 0;
+    for(unsigned state = 1; state < _trellis.numStates(); ++state)
+    {
+        if(_pathMetrics[state][lane] > _pathMetrics[bestState][lane]) bestState = state;
+    }
+
+    return bestState;
+}
+
+template <bool Packed>
+unsigned MultiFrameViterbiDecoder::_traceback(size_t lane, unsigned endState, std::uint8_t* output) const
+{
+    const unsigned numStates = _trellis.numStates();
+    const unsigned stateMask = numStates - 1;
+    const unsigned registerBitShift = static_cast<unsigned>(_trellis.K() - 2);
+
+    TracebackBitWriter<Packed> writer(output);
+
+    // Flushed frames output the bits before the tail.
+    unsigned state = endState;
+    for(size_t step = _numSteps; step > 0; --step)
+    {
+        const unsigned registerBit = state >> registerBitShift;
+        const unsigned decision = _decisions[((step-1) * numStates) + state][lane] & 1;
+        const unsigned prevState = ((state << 1) & stateMask) | decision;
+
+        if((step-1) < _length)
+        {
+            writer.write((step-1), _trellis.inputBit(prevState, registerBit));
+        }
+
+        state = prevState;
+    }
+
+    return state;
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "ConvCodeConfig.hpp"
+#include "ConvTrellis.hpp"
+#include "ConvolutionUtility.hpp"
+#include "VectorTypes.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A hard-decision Viterbi decoder that decodes NumLanes independent frames
+// of the same code at once, one frame per SIMD lane. Codes with few states
+// leave most of a vector register idle when vectorizing across the states
+// of a single frame, but every lane does useful work here.
+//
+// Like ViterbiDecoder, all memory is allocated on construction, the forward
+// pass is instantiated for the standard codes' constraint lengths and rates,
+// and tail-biting frames are decoded with wrap-around passes. Each frame's
+// output is taken from the first pass on which it converges, but passes
+// continue until every frame has converged.
+class MultiFrameViterbiDecoder
+{
+public:
+    using UPtr = std::unique_ptr<MultiFrameViterbiDecoder>;
+
+    static constexpr size_t NumLanes = 16;
+
+    explicit MultiFrameViterbiDecoder(const ConvCodeConfig::SPtr& config);
+
+    inline const ConvCodeConfig::SPtr& config() const
+    {
+        return _config;
+    }
+
+    // Decodes NumLanes consecutive frames of config()->encodedLength() soft
+    // bits each into NumLanes consecutive frames of hard bits.
+    void decode(const std::int8_t* input, std::uint8_t* output);
+
+    // As above, but outputs each frame's bits MSB-first into
+    // ceil(config()->convCode().len / 8) bytes.
+    void decodePacked(const std::int8_t* input, std::uint8_t* output);
+
+    inline size_t maxTailBitingIterations() const
+    {
+        return _maxTailBitingIterations;
+    }
+
+    void setMaxTailBitingIterations(size_t maxTailBitingIterations);
+
+    // Returns the totals since the last call.
+    TailBitingStats takeTailBitingStats();
+
+private:
+    using ForwardFcn = void(MultiFrameViterbiDecoder::*)(bool);
+
+    ConvCodeConfig::SPtr _config;
+    ConvTrellis _trellis;
+
+    size_t _length;
+    size_t _encodedLength;
+    bool _isTailBiting;
+    size_t _numSteps;
+
+    size_t _maxTailBitingIterations;
+    TailBitingStats _tailBitingStats;
+
+    std::vector<int> _depunctureMap;
+
+    // Depunctured symbols, transposed so that each symbol holds that bit
+    // position for every frame.
+    AlignedArray<Int16x16> _symbols;
+
+    AlignedArray<Int16x16> _branchMetrics;
+    AlignedArray<Int16x16> _pathMetrics;
+    AlignedArray<Int16x16> _nextPathMetrics;
+    AlignedArray<Int8x16> _decisions;
+
+    ForwardFcn _forwardFcn;
+
+    template <bool Packed>
+    void _decode(const std::int8_t* input, std::uint8_t* output);
+
+    // Each pass after the first starts from the previous pass's final
+    // metrics, which is only done for tail-biting frames.
+    //
+    // FixedK and FixedN are 0 to read the code's shape at runtime.
+    template <int FixedK, int FixedN>
+    void _forward(bool isFirstPass);
+
+    unsigned _bestState(size_t lane) const;
+
+    // Returns the state the lane's traced path starts in.
+    template <bool Packed>
+    unsigned _traceback(size_t lane, unsigned endState, std::uint8_t* output) const;
+};
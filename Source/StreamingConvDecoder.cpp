@@ -0,0 +1,366 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ConvolutionUtility.hpp"
+#include "StreamingViterbiDecoder.hpp"
+
+#include <Pothos/Callable.hpp>
+#include <Pothos/Exception.hpp>
+#include <Pothos/Framework.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Bounds the decision memory, independent of how much input is available.
+static constexpr size_t MaxStepsPerWork = 4096;
+
+// Note: defaults come from the CCSDS/802.11 K=7 rate 1/2 code.
+static lte_conv_code getDefaultConvCode()
+{
+    lte_conv_code convCode;
+    std::memset(&convCode, 0, sizeof(convCode));
+
+    convCode.n = 2;
+    convCode.k = 7;
+    convCode.len = 1;
+    convCode.rgen = 0;
+    convCode.gen[0] = 0171;
+    convCode.gen[1] = 0133;
+    convCode.punc = nullptr;
+    convCode.term = ::CONV_TERM_FLUSH;
+
+    return convCode;
+}
+static constexpr size_t DefaultGenArrLength = 2;
+static constexpr size_t DefaultTracebackDepth = 64;
+
+// Decodes a continuous stream of soft bits. Unlike the other decoders,
+// there are no frames, so path metrics carry over between calls to work(),
+// and each bit is output once the decoder is tracebackDepth steps past it.
+//
+// Puncturing is given as a pattern of which unpunctured outputs are kept,
+// repeated over the whole stream. Punctured bits are decoded as erasures.
+//
+// Changing any parameter restarts decoding from the next input, dropping
+// any bits that haven't been output yet.
+class StreamingConvDecoder: public Pothos::Block
+{
+public:
+    static Pothos::Block* make()
+    {
+        return new StreamingConvDecoder();
+    }
+
+    StreamingConvDecoder():
+        Pothos::Block(),
+        _convCode(getDefaultConvCode()),
+        _genArrLength(DefaultGenArrLength),
+        _tracebackDepth(DefaultTracebackDepth),
+        _punctureIndex(0),
+        _depunctured(MaxStepsPerWork * 4),
+        _numPartialSymbols(0)
+    {
+        this->_rebuild(_convCode, _puncturePattern, _tracebackDepth);
+
+        this->setupInput(0, "int8");
+        this->setupOutput(0, "uint8");
+
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, N));
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, setN));
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, K));
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, setK));
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, rgen));
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, setRGen));
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, gen));
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, setGen));
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, puncturePattern));
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, setPuncturePattern));
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, tracebackDepth));
+        this->registerCall(this, POTHOS_FCN_TUPLE(StreamingConvDecoder, setTracebackDepth));
+
+        this->registerProbe("N");
+        this->registerProbe("K");
+        this->registerProbe("rgen");
+        this->registerProbe("gen");
+        this->registerProbe("puncturePattern");
+        this->registerProbe("tracebackDepth");
+
+        this->registerSignal("NChanged");
+        this->registerSignal("KChanged");
+        this->registerSignal("rgenChanged");
+        this->registerSignal("genChanged");
+        this->registerSignal("puncturePatternChanged");
+        this->registerSignal("tracebackDepthChanged");
+    }
+
+    int N() const
+    {
+        return _convCode.n;
+    }
+
+    void setN(int n)
+    {
+        auto convCode = _convCode;
+        convCode.n = n;
+
+        this->_rebuild(convCode, _puncturePattern, _tracebackDepth);
+
+        this->emitSignal("NChanged", n);
+    }
+
+    int K() const
+    {
+        return _convCode.k;
+    }
+
+    void setK(int k)
+    {
+        auto convCode = _convCode;
+        convCode.k = k;
+
+        this->_rebuild(convCode, _puncturePattern, _tracebackDepth);
+
+        this->emitSignal("KChanged", k);
+    }
+
+    unsigned rgen() const
+    {
+        return _convCode.rgen;
+    }
+
+    void setRGen(unsigned rgen)
+    {
+        auto convCode = _convCode;
+        convCode.rgen = rgen;
+
+        this->_rebuild(convCode, _puncturePattern, _tracebackDepth);
+
+        this->emitSignal("rgenChanged", rgen);
+    }
+
+    std::vector<unsigned> gen() const
+    {
+        return std::vector<unsigned>(_convCode.gen, _convCode.gen + _genArrLength);
+    }
+
+    void setGen(const std::vector<unsigned>& gen)
+    {
+        if(gen.size() > 4)
+        {
+            throw Pothos::InvalidArgumentException("Gen must be of size 0-4");
+        }
+
+        auto convCode = _convCode;
+        std::memset(convCode.gen, 0, sizeof(convCode.gen));
+        std::copy(gen.begin(), gen.end(), convCode.gen);
+
+        this->_rebuild(convCode, _puncturePattern, _tracebackDepth);
+        _genArrLength = gen.size();
+
+        this->emitSignal("genChanged", gen);
+    }
+
+    std::vector<int> puncturePattern() const
+    {
+        return _puncturePattern;
+    }
+
+    void setPuncturePattern(const std::vector<int>& puncturePattern)
+    {
+        this->_rebuild(_convCode, puncturePattern, _tracebackDepth);
+
+        this->emitSignal("puncturePatternChanged", puncturePattern);
+    }
+
+    size_t tracebackDepth() const
+    {
+        return _tracebackDepth;
+    }
+
+    void setTracebackDepth(size_t tracebackDepth)
+    {
+        this->_rebuild(_convCode, _puncturePattern, tracebackDepth);
+
+        this->emitSignal("tracebackDepthChanged", tracebackDepth);
+    }
+
+    void activate() override
+    {
+        this->_reset();
+    }
+
+    void work() override
+    {
+        auto input = this->input(0);
+        auto output = this->output(0);
+
+        const auto numInputElems = input->elements();
+        const auto maxSteps = std::min(output->elements(), MaxStepsPerWork);
+        if((0 == numInputElems) || (0 == maxSteps)) return;
+
+        const auto* inBuff = input->buffer().as<const std::int8_t*>();
+        auto* outBuff = output->buffer().as<std::uint8_t*>();
+
+        const size_t N = static_cast<size_t>(_convCode.n);
+        const size_t maxSymbols = maxSteps * N;
+
+        // Depuncture as many whole steps as we have input and output space
+        // for, carrying over any partial step from the last call. Punctured
+        // positions past the end of our input are filled in too, as they
+        // don't depend on it.
+        size_t inputIndex = 0;
+        size_t numSymbols = _numPartialSymbols;
+        while(numSymbols < maxSymbols)
+        {
+            if(this->_isPunctured())
+            {
+                _depunctured[numSymbols++] = 0;
+            }
+            else if(inputIndex < numInputElems)
+            {
+                _depunctured[numSymbols++] = inBuff[inputIndex++];
+            }
+            else break;
+
+            if(!_puncturePattern.empty()) _punctureIndex = (_punctureIndex + 1) % _puncturePattern.size();
+        }
+
+        const size_t numSteps = numSymbols / N;
+        const size_t numOutputElems = _decoder->decode(_depunctured.data(), numSteps, outBuff);
+
+        _numPartialSymbols = numSymbols - (numSteps * N);
+        std::memmove(
+            _depunctured.data(),
+            &_depunctured[numSteps * N],
+            _numPartialSymbols);
+
+        input->consume(inputIndex);
+        if(numOutputElems > 0) output->produce(numOutputElems);
+    }
+
+private:
+    lte_conv_code _convCode;
+    size_t _genArrLength;
+    std::vector<int> _puncturePattern;
+    size_t _tracebackDepth;
+
+    StreamingViterbiDecoder::UPtr _decoder;
+
+    // Our position in the puncture pattern, and the depunctured symbols
+    // waiting to be decoded, with any partial step at the front between
+    // calls to work()
+    size_t _punctureIndex;
+    std::vector<std::int8_t> _depunctured;
+    size_t _numPartialSymbols;
+
+    inline bool _isPunctured() const
+    {
+        return (!_puncturePattern.empty() && (0 == _puncturePattern[_punctureIndex]));
+    }
+
+    // Only updates the block's parameters once the new decoder is built, so
+    // invalid parameters leave the block as it was.
+    void _rebuild(
+        const lte_conv_code& convCode,
+        const std::vector<int>& puncturePattern,
+        size_t tracebackDepth)
+    {
+        validateConvCode(convCode);
+
+        if(!puncturePattern.empty())
+        {
+            auto invalidIter = std::find_if(
+                                   puncturePattern.begin(),
+                                   puncturePattern.end(),
+                                   [](int keep)
+                                   {
+                                       return (keep != 0) && (keep != 1);
+                                   });
+            if(puncturePattern.end() != invalidIter)
+            {
+                throw Pothos::InvalidArgumentException("All puncture pattern values must be 0 or 1.");
+            }
+            if(puncturePattern.end() == std::find(puncturePattern.begin(), puncturePattern.end(), 1))
+            {
+                throw Pothos::InvalidArgumentException("The puncture pattern must keep at least one bit.");
+            }
+        }
+
+        _decoder.reset(new StreamingViterbiDecoder(convCode, tracebackDepth, MaxStepsPerWork));
+        _convCode = convCode;
+        _puncturePattern = puncturePattern;
+        _tracebackDepth = tracebackDepth;
+
+        this->_reset();
+    }
+
+    void _reset()
+    {
+        _decoder->reset();
+        _punctureIndex = 0;
+        _numPartialSymbols = 0;
+    }
+};
+
+/*
+ * |PothosDoc Streaming Convolution Decoder
+ *
+ * Decodes a continuous stream of soft bits, where positive values correspond to 1,
+ * encoded with a convolutional code that is never terminated, such as 802.11 or
+ * CCSDS telemetry. Unlike the block decoders, there are no frame boundaries. Path
+ * metrics carry over from one call to the next, and each bit is output once the
+ * decoder has seen the given traceback depth of later bits, so the output lags
+ * the input by that many bits.
+ *
+ * Changing any parameter restarts decoding, dropping any bits not yet output.
+ *
+ * |category /FEC/Convolution
+ * |keywords N K gen recursive viterbi continuous stream traceback ccsds wifi
+ * |factory /fec/streaming_conv_decoder()
+ * |setter setN(N)
+ * |setter setK(K)
+ * |setter setRGen(rgen)
+ * |setter setGen(gen)
+ * |setter setPuncturePattern(puncturePattern)
+ * |setter setTracebackDepth(tracebackDepth)
+ *
+ * |param N[Rate] 2, 3, 4 (corresponding to 1/2, 1/3, 1/4)
+ * |widget SpinBox(minimum=2,maximum=4)
+ * |default 2
+ * |preview enable
+ *
+ * |param K[Constraint Length] 3 through 9
+ * |widget SpinBox(minimum=3,maximum=9)
+ * |default 7
+ * |preview enable
+ *
+ * |param rgen[RGen] Recursive generator polynomial
+ * |widget SpinBox(minimum=0,base=8)
+ * |default 0
+ * |preview enable
+ *
+ * |param gen[Gen] Generator polynomial (length 0-4)
+ * |widget LineEdit()
+ * |default [0o171,0o133]
+ * |preview enable
+ *
+ * |param puncturePattern[Puncture Pattern]
+ * Which of the encoder's unpunctured output bits are kept (1) or punctured (0),
+ * repeated over the whole stream. For example, [1,1,1,0,0,1] punctures a rate 1/2
+ * code to rate 3/4. If empty, no bits are punctured.
+ * |widget LineEdit()
+ * |default []
+ * |preview enable
+ *
+ * |param tracebackDepth[Traceback Depth]
+ * How many later bits the decoder waits for before deciding each bit. Five to ten
+ * times the constraint length is typical, with more needed for punctured codes.
+ * |widget SpinBox(minimum=1)
+ * |default 64
+ * |preview enable
+ */
+static Pothos::BlockRegistry registerStreamingConvDecoder(
+    "/fec/streaming_conv_decoder",
+    Pothos::Callable(&StreamingConvDecoder::make));
@@ -0,0 +1,286 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "StreamingViterbiDecoder.hpp"
+
+#include <Pothos/Exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+static constexpr size_t NumLanes = sizeof(Int16x16) / sizeof(std::int16_t);
+
+// The vectorized pass processes the butterflies of 16 consecutive states
+// at once, which requires at least 32 states.
+static constexpr int MinVectorK = 6;
+
+StreamingViterbiDecoder::StreamingViterbiDecoder(
+    const lte_conv_code& convCode,
+    size_t tracebackDepth,
+    size_t maxStepsPerCall
+):
+    _trellis(convCode),
+    _tracebackDepth(tracebackDepth),
+    _maxStepsPerCall(maxStepsPerCall),
+    _numBufferedSteps(0),
+    _forwardFcn(nullptr)
+{
+    if(0 == _tracebackDepth)
+    {
+        throw Pothos::InvalidArgumentException("The traceback depth must be positive");
+    }
+    if(0 == _maxStepsPerCall)
+    {
+        throw Pothos::InvalidArgumentException("The maximum steps per call must be positive");
+    }
+
+    const int N = _trellis.N();
+    const unsigned numStates = _trellis.numStates();
+
+    switch(_trellis.K())
+    {
+        case 3: _forwardFcn = &StreamingViterbiDecoder::_forward<3>; break;
+        case 4: _forwardFcn = &StreamingViterbiDecoder::_forward<4>; break;
+        case 5: _forwardFcn = &StreamingViterbiDecoder::_forward<5>; break;
+        case 6: _forwardFcn = &StreamingViterbiDecoder::_forwardVector<6>; break;
+        case 7: _forwardFcn = &StreamingViterbiDecoder::_forwardVector<7>; break;
+        case 8: _forwardFcn = &StreamingViterbiDecoder::_forwardVector<8>; break;
+        case 9: _forwardFcn = &StreamingViterbiDecoder::_forwardVector<9>; break;
+
+        default:
+            throw Pothos::InvalidArgumentException(
+                      "StreamingViterbiDecoder: unsupported constraint length",
+                      std::to_string(_trellis.K()));
+    }
+
+    if(_trellis.K() < MinVectorK)
+    {
+        _branchMetrics.resize(1U << N);
+        _pathMetrics.resize(numStates);
+        _nextPathMetrics.resize(numStates);
+    }
+    else
+    {
+        const unsigned numGroups = numStates / (2 * NumLanes);
+
+        _outputSigns = AlignedArray<Int16x16>(numGroups * 2 * 2 * N);
+        _vectorPathMetrics = AlignedArray<Int16x16>(numStates / NumLanes);
+        _nextVectorPathMetrics = AlignedArray<Int16x16>(numStates / NumLanes);
+
+        for(unsigned group = 0; group < numGroups; ++group)
+        {
+            for(unsigned registerBit = 0; registerBit < 2; ++registerBit)
+            {
+                for(unsigned parity = 0; parity < 2; ++parity)
+                {
+                    auto* outputSigns = &_outputSigns[(((group * 2) + registerBit) * 2 + parity) * N];
+
+                    for(size_t lane = 0; lane < NumLanes; ++lane)
+                    {
+                        const unsigned prevState = (2 * ((group * NumLanes) + lane)) + parity;
+                        const unsigned output = _trellis.output(prevState, registerBit);
+
+                        for(int i = 0; i < N; ++i)
+                        {
+                            outputSigns[i][lane] = ((output >> i) & 1) ? 1 : -1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    _decisions.resize((_tracebackDepth + _maxStepsPerCall) * numStates);
+
+    this->reset();
+}
+
+void StreamingViterbiDecoder::reset()
+{
+    // A stream can be picked up at any point, so all states start out
+    // equally likely.
+    std::fill(_pathMetrics.begin(), _pathMetrics.end(), 0);
+    for(auto& pathMetric: _vectorPathMetrics) pathMetric = Int16x16{0};
+
+    _numBufferedSteps = 0;
+}
+
+size_t StreamingViterbiDecoder::decode(const std::int8_t* input, size_t numSteps, std::uint8_t* output)
+{
+    if(numSteps > _maxStepsPerCall)
+    {
+        throw Pothos::InvalidArgumentException(
+                  "StreamingViterbiDecoder: too many steps for one call",
+                  std::to_string(numSteps));
+    }
+
+    (this->*_forwardFcn)(input, numSteps);
+    _numBufferedSteps += numSteps;
+
+    if(_numBufferedSteps <= _tracebackDepth) return 0;
+
+    const unsigned numStates = _trellis.numStates();
+    const unsigned stateMask = numStates - 1;
+    const unsigned registerBitShift = static_cast<unsigned>(_trellis.K() - 2);
+
+    // Trace back from the most likely state over every buffered step, and
+    // output the bits older than the traceback depth.
+    const size_t numOutputBits = _numBufferedSteps - _tracebackDepth;
+
+    unsigned state = this->_bestState();
+    for(size_t step = _numBufferedSteps; step > 0; --step)
+    {
+        const unsigned registerBit = state >> registerBitShift;
+        const unsigned decision = _decisions[((step-1) * numStates) + state] & 1;
+        const unsigned prevState = ((state << 1) & stateMask) | decision;
+
+        if((step-1) < numOutputBits)
+        {
+            output[step-1] = static_cast<std::uint8_t>(_trellis.inputBit(prevState, registerBit));
+        }
+
+        state = prevState;
+    }
+
+    // Keep the undecided steps' decisions at the front of the buffer.
+    std::memmove(
+        _decisions.data(),
+        &_decisions[numOutputBits * numStates],
+        (_tracebackDepth * numStates));
+    _numBufferedSteps = _tracebackDepth;
+
+    return numOutputBits;
+}
+
+unsigned StreamingViterbiDecoder::_bestState() const
+{
+    if(_trellis.K() < MinVectorK)
+    {
+        return static_cast<unsigned>(std::distance(
+                   _pathMetrics.begin(),
+                   std::max_element(_pathMetrics.begin(), _pathMetrics.end())));
+    }
+
+    unsigned bestState = 0;
+    for(unsigned state = 1; state < _trellis.numStates(); ++state)
+    {
+        if(_vectorPathMetrics[state / NumLanes][state % NumLanes] >
+           _vectorPathMetrics[bestState / NumLanes][bestState % NumLanes])
+        {
+            bestState = state;
+        }
+    }
+
+    return bestState;
+}
+
+template <int K>
+void StreamingViterbiDecoder::_forward(const std::int8_t* input, size_t numSteps)
+{
+    constexpr unsigned numStates = 1U << (K - 1);
+    constexpr unsigned stateMask = numStates - 1;
+    constexpr unsigned registerBitShift = K - 2;
+
+    const int N = _trellis.N();
+
+    for(size_t step = 0; step < numSteps; ++step)
+    {
+        const auto* symbols = &input[step * N];
+
+        for(size_t output = 0; output < _branchMetrics.size(); ++output)
+        {
+            std::int32_t branchMetric = 0;
+            for(int i = 0; i < N; ++i)
+            {
+                branchMetric += ((output >> i) & 1) ? symbols[i] : -symbols[i];
+            }
+            _branchMetrics[output] = branchMetric;
+        }
+
+        auto* decisions = &_decisions[(_numBufferedSteps + step) * numStates];
+
+        for(unsigned state = 0; state < numStates; ++state)
+        {
+            const unsigned registerBit = state >> registerBitShift;
+            const unsigned prevState0 = (state << 1) & stateMask;
+            const unsigned prevState1 = prevState0 | 1;
+
+            const auto metric0 = _pathMetrics[prevState0] + _branchMetrics[_trellis.output(prevState0, registerBit)];
+            const auto metric1 = _pathMetrics[prevState1] + _branchMetrics[_trellis.output(prevState1, registerBit)];
+
+            decisions[state] = (metric1 > metric0) ? 1 : 0;
+            _nextPathMetrics[state] = std::max(metric0, metric1);
+        }
+
+        _pathMetrics.swap(_nextPathMetrics);
+    }
+
+    // The metrics would otherwise grow without bound over the stream. A
+    // call's worth of steps can't overflow them on its own.
+    const auto maxMetric = *std::max_element(_pathMetrics.begin(), _pathMetrics.end());
+    for(auto& metric: _pathMetrics) metric -= maxMetric;
+}
+
+// As in ViterbiDecoder, each group handles 32 consecutive predecessors and
+// the 16 states in each half of the state space they lead to.
+template <int K>
+void StreamingViterbiDecoder::_forwardVector(const std::int8_t* input, size_t numSteps)
+{
+    constexpr unsigned numStates = 1U << (K - 1);
+    constexpr unsigned numVectors = numStates / NumLanes;
+    constexpr unsigned numGroups = numVectors / 2;
+
+    const int N = _trellis.N();
+
+    const Int16x16 zeros = {0};
+    Int16x16 symbols[4];
+
+    for(size_t step = 0; step < numSteps; ++step)
+    {
+        const auto* stepSymbols = &input[step * N];
+        for(int i = 0; i < N; ++i) symbols[i] = zeros + stepSymbols[i];
+
+        auto* decisions = &_decisions[(_numBufferedSteps + step) * numStates];
+
+        for(unsigned group = 0; group < numGroups; ++group)
+        {
+            Int16x16 evenMetrics, oddMetrics;
+            deinterleave(
+                _vectorPathMetrics[2 * group],
+                _vectorPathMetrics[(2 * group) + 1],
+                evenMetrics,
+                oddMetrics);
+
+            for(unsigned registerBit = 0; registerBit < 2; ++registerBit)
+            {
+                const auto* evenSigns = &_outputSigns[(((group * 2) + registerBit) * 2) * N];
+                const auto* oddSigns = evenSigns + N;
+
+                Int16x16 metric0 = evenMetrics;
+                Int16x16 metric1 = oddMetrics;
+                for(int i = 0; i < N; ++i)
+                {
+                    metric0 += evenSigns[i] * symbols[i];
+                    metric1 += oddSigns[i] * symbols[i];
+                }
+
+                const Int16x16 decision = (metric1 > metric0);
+
+                const unsigned nextVector = (registerBit * numGroups) + group;
+                _nextVectorPathMetrics[nextVector] = decision ? metric1 : metric0;
+
+                const Int8x16 decisionBytes = __builtin_convertvector(decision, Int8x16);
+                std::memcpy(&decisions[nextVector * NumLanes], &decisionBytes, sizeof(decisionBytes));
+            }
+        }
+
+        // Normalizing against state 0 on every step bounds the spread
+        // between states to well within 16 bits, however long the stream.
+        const Int16x16 normalization = zeros + _nextVectorPathMetrics[0][0];
+        for(unsigned vec = 0; vec < numVectors; ++vec)
+        {
+            _vectorPathMetrics[vec] = _nextVectorPathMetrics[vec] - normalization;
+        }
+    }
+}
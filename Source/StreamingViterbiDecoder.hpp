@@ -0,0 +1,95 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "ConvTrellis.hpp"
+#include "VectorTypes.hpp"
+
+extern "C"
+{
+#include <turbofec/conv.h>
+}
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A hard-decision Viterbi decoder for continuous streams, which have no
+// block boundaries or termination. Path metrics carry over from one call
+// to the next, and each bit is decided once tracebackDepth() later steps
+// have been decoded, by which point the surviving paths have almost always
+// merged.
+//
+// All memory is allocated on construction. Like ViterbiDecoder, codes with
+// enough states to fill a vector register are vectorized across states.
+class StreamingViterbiDecoder
+{
+public:
+    using UPtr = std::unique_ptr<StreamingViterbiDecoder>;
+
+    // Only the code's rate, constraint length, and generators are used.
+    StreamingViterbiDecoder(
+        const lte_conv_code& convCode,
+        size_t tracebackDepth,
+        size_t maxStepsPerCall);
+
+    inline const ConvTrellis& trellis() const
+    {
+        return _trellis;
+    }
+
+    inline size_t tracebackDepth() const
+    {
+        return _tracebackDepth;
+    }
+
+    inline size_t maxStepsPerCall() const
+    {
+        return _maxStepsPerCall;
+    }
+
+    // Decodes numSteps (at most maxStepsPerCall()) steps of N soft bits
+    // each, where positive values correspond to 1 and 0 is an erasure.
+    // Returns the number of bits output, which is at most numSteps.
+    size_t decode(const std::int8_t* input, size_t numSteps, std::uint8_t* output);
+
+    // Forgets all previous input, so the next step can start in any state.
+    void reset();
+
+private:
+    using ForwardFcn = void(StreamingViterbiDecoder::*)(const std::int8_t*, size_t);
+
+    ConvTrellis _trellis;
+
+    size_t _tracebackDepth;
+    size_t _maxStepsPerCall;
+
+    // The steps whose decisions are buffered but whose bits haven't been
+    // output, which is at most tracebackDepth() between calls.
+    size_t _numBufferedSteps;
+
+    ForwardFcn _forwardFcn;
+
+    // Used by the scalar forward pass
+    std::vector<std::int32_t> _branchMetrics;
+    std::vector<std::int32_t> _pathMetrics;
+    std::vector<std::int32_t> _nextPathMetrics;
+
+    // Used by the vectorized forward pass, laid out as in ViterbiDecoder.
+    AlignedArray<Int16x16> _outputSigns;
+    AlignedArray<Int16x16> _vectorPathMetrics;
+    AlignedArray<Int16x16> _nextVectorPathMetrics;
+
+    // One byte per state per buffered step, where the low bit is set if
+    // the odd predecessor was chosen.
+    std::vector<std::uint8_t> _decisions;
+
+    unsigned _bestState() const;
+
+    template <int K>
+    void _forward(const std::int8_t* input, size_t numSteps);
+
+    template <int K>
+    void _forwardVector(const std::int8_t* input, size_t numSteps);
+};
@@ -0,0 +1,146 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <stdlib.h>
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Portable SIMD types using GCC/Clang vector extensions. These compile to
+// AVX2 when it's enabled, and are split into SSE/NEON operations otherwise.
+
+typedef std::uint8_t Uint8x16 __attribute__((vector_size(16)));
+typedef std::int8_t Int8x16 __attribute__((vector_size(16)));
+typedef std::int16_t Int16x8 __attribute__((vector_size(16)));
+typedef std::int16_t Int16x16 __attribute__((vector_size(32)));
+typedef std::int32_t Int32x16 __attribute__((vector_size(64)));
+
+// A fixed-size, zero-initialized heap array that respects the alignment of
+// vector types, which std::vector's allocator doesn't before C++17.
+template <typename T>
+class AlignedArray
+{
+public:
+    static_assert(std::is_trivial<T>::value, "AlignedArray only supports trivial types");
+
+    AlignedArray():
+        _data(nullptr),
+        _size(0)
+    {}
+
+    explicit AlignedArray(size_t size):
+        _data(nullptr),
+        _size(size)
+    {
+        constexpr size_t alignment = (alignof(T) > sizeof(void*)) ? alignof(T) : sizeof(void*);
+
+        void* data = nullptr;
+        if(0 != ::posix_memalign(&data, alignment, (_size * sizeof(T)) + 1)) throw std::bad_alloc();
+
+        std::memset(data, 0, (_size * sizeof(T)));
+        _data = static_cast<T*>(data);
+    }
+
+    AlignedArray(const AlignedArray&) = delete;
+    AlignedArray& operator=(const AlignedArray&) = delete;
+
+    AlignedArray(AlignedArray&& other):
+        _data(other._data),
+        _size(other._size)
+    {
+        other._data = nullptr;
+        other._size = 0;
+    }
+
+    AlignedArray& operator=(AlignedArray&& other)
+    {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+
+        return *this;
+    }
+
+    ~AlignedArray()
+    {
+        ::free(_data);
+    }
+
+    inline T& operator[](size_t index)
+    {
+        return _data[index];
+    }
+
+    inline const T& operator[](size_t index) const
+    {
+        return _data[index];
+    }
+
+    inline T* data()
+    {
+        return _data;
+    }
+
+    inline const T* data() const
+    {
+        return _data;
+    }
+
+    inline size_t size() const
+    {
+        return _size;
+    }
+
+    inline T* begin()
+    {
+        return _data;
+    }
+
+    inline T* end()
+    {
+        return (_data + _size);
+    }
+
+private:
+    T* _data;
+    size_t _size;
+};
+
+// Splits the 32 elements of the given vectors into the even- and
+// odd-indexed elements.
+static inline void deinterleave(
+    const Int16x16& first,
+    const Int16x16& second,
+    Int16x16& evens,
+    Int16x16& odds)
+{
+#if defined(__clang__)
+    evens = __builtin_shufflevector(first, second, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+    odds = __builtin_shufflevector(first, second, 1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31);
+#else
+    static const Int16x16 evenIndices = {0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30};
+    static const Int16x16 oddIndices = evenIndices + 1;
+
+    evens = __builtin_shuffle(first, second, evenIndices);
+    odds = __builtin_shuffle(first, second, oddIndices);
+#endif
+}
+
+// Adds the given vectors, saturating at the int8 limits instead of
+// wrapping around.
+static inline Int8x16 saturatingAdd(const Int8x16& a, const Int8x16& b)
+{
+    // Add unsigned, since signed overflow is undefined.
+    const Int8x16 sum = (Int8x16)((Uint8x16)a + (Uint8x16)b);
+
+    // Only values of the same sign can overflow, which flips the sign of
+    // the sum.
+    const Int8x16 overflowed = ((a ^ sum) & (b ^ sum)) < 0;
+    const Int8x16 limits = (a >> 7) ^ 127;
+
+    return (sum & ~overflowed) | (limits & overflowed);
+}
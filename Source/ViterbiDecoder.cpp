@@ -0,0 +1,363 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ViterbiDecoder.hpp"
+#include "ConvolutionUtility.hpp"
+
+#include <Pothos/Exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+
+// Low enough that no path starting from an invalid state can win, but high
+// enough that adding branch metrics won't overflow.
+static constexpr std::int32_t InvalidPathMetric = std::numeric_limits<std::int32_t>::min() / 2;
+
+// The vectorized pass normalizes against state 0 on every step, which
+// bounds the spread between states to well within 16 bits for int8 inputs.
+static constexpr std::int16_t InvalidVectorPathMetric = -16384;
+
+// Path metrics only grow, so periodically subtract the best metric to
+// keep them from overflowing on long frames.
+static constexpr size_t NormalizeInterval = 1024;
+
+static constexpr size_t NumLanes = sizeof(Int16x16) / sizeof(std::int16_t);
+
+// The vectorized pass processes the butterflies of 16 consecutive states
+// at once, which requires at least 32 states.
+static constexpr int MinVectorK = 6;
+
+ViterbiDecoder::ViterbiDecoder(const ConvCodeConfig::SPtr& config):
+    _config(config),
+    _trellis(config->convCode()),
+    _length(static_cast<size_t>(config->convCode().len)),
+    _isTailBiting(::CONV_TERM_TAIL_BITING == config->convCode().term),
+    _numSteps(_isTailBiting ? _length : (_length + config->convCode().k - 1)),
+    _maxTailBitingIterations(DefaultMaxTailBitingIterations),
+    _tailBitingStats(),
+    _depunctureMap(getConvDepunctureMap(config->convCode(), config->convCode().len)),
+    _depunctured(_depunctureMap.size()),
+    _forwardFcn(nullptr),
+    _decisions(_numSteps * _trellis.numStates()),
+    _endState(0)
+{
+    const int N = _trellis.N();
+    const unsigned numStates = _trellis.numStates();
+
+    // The vectorized pass is bound by the butterflies rather than the
+    // branch metrics, so fixing the rate only pays off for the scalar pass.
+    switch(convCodeShape(_trellis.K(), N))
+    {
+        case convCodeShape(5, 2): _forwardFcn = &ViterbiDecoder::_forward<5, 2>; break;
+        case convCodeShape(5, 3): _forwardFcn = &ViterbiDecoder::_forward<5, 3>; break;
+        case convCodeShape(5, 4): _forwardFcn = &ViterbiDecoder::_forward<5, 4>; break;
+
+        default:
+            switch(_trellis.K())
+            {
+                case 3: _forwardFcn = &ViterbiDecoder::_forward<3, 0>; break;
+                case 4: _forwardFcn = &ViterbiDecoder::_forward<4, 0>; break;
+                case 5: _forwardFcn = &ViterbiDecoder::_forward<5, 0>; break;
+                case 6: _forwardFcn = &ViterbiDecoder::_forwardVector<6>; break;
+                case 7: _forwardFcn = &ViterbiDecoder::_forwardVector<7>; break;
+                case 8: _forwardFcn = &ViterbiDecoder::_forwardVector<8>; break;
+                case 9: _forwardFcn = &ViterbiDecoder::_forwardVector<9>; break;
+
+                default:
+                    throw Pothos::InvalidArgumentException(
+                              "ViterbiDecoder: unsupported constraint length",
+                              std::to_string(_trellis.K()));
+            }
+            break;
+    }
+
+    if(_trellis.K() < MinVectorK)
+    {
+        _branchMetrics.resize(1U << N);
+        _pathMetrics.resize(numStates);
+        _nextPathMetrics.resize(numStates);
+    }
+    else
+    {
+        const unsigned numGroups = numStates / (2 * NumLanes);
+
+        _outputSigns = AlignedArray<Int16x16>(numGroups * 2 * 2 * N);
+        _vectorPathMetrics = AlignedArray<Int16x16>(numStates / NumLanes);
+        _nextVectorPathMetrics = AlignedArray<Int16x16>(numStates / NumLanes);
+
+        for(unsigned group = 0; group < numGroups; ++group)
+        {
+            for(unsigned registerBit = 0; registerBit < 2; ++registerBit)
+            {
+                for(unsigned parity = 0; parity < 2; ++parity)
+                {
+                    auto* outputSigns = &_outputSigns[(((group * 2) + registerBit) * 2 + parity) * N];
+
+                    for(size_t lane = 0; lane < NumLanes; ++lane)
+                    {
+                        const unsigned prevState = (2 * ((group * NumLanes) + lane)) + parity;
+                        const unsigned output = _trellis.output(prevState, registerBit);
+
+                        for(int i = 0; i < N; ++i)
+                        {
+                            outputSigns[i][lane] = ((output >> i) & 1) ? 1 : -1;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ViterbiDecoder::decode(const std::int8_t* input, std::uint8_t* output)
+{
+    this->_decode<false>(input, output);
+}
+
+void ViterbiDecoder::decodePacked(const std::int8_t* input, std::uint8_t* output)
+{
+    this->_decode<true>(input, output);
+}
+
+void ViterbiDecoder::setMaxTailBitingIterations(size_t maxTailBitingIterations)
+{
+    if(0 == maxTailBitingIterations)
+    {
+        throw Pothos::InvalidArgumentException("The maximum tail-biting iterations must be positive");
+    }
+
+    _maxTailBitingIterations = maxTailBitingIterations;
+}
+
+TailBitingStats ViterbiDecoder::takeTailBitingStats()
+{
+    const auto stats = _tailBitingStats;
+    _tailBitingStats = TailBitingStats();
+
+    return stats;
+}
+
+template <bool Packed>
+void ViterbiDecoder::_decode(const std::int8_t* input, std::uint8_t* output)
+{
+    // Punctured bits carry no information, so they're treated as erasures.
+    for(size_t i = 0; i < _depunctureMap.size(); ++i)
+    {
+        _depunctured[i] = (_depunctureMap[i] >= 0) ? input[_depunctureMap[i]] : 0;
+    }
+
+    if(!_isTailBiting)
+    {
+        (this->*_forwardFcn)(true);
+        this->_traceback<Packed>(output);
+        return;
+    }
+
+    size_t iteration = 0;
+    bool isStateMatch = false;
+    while(!isStateMatch && (iteration < _maxTailBitingIterations))
+    {
+        (this->*_forwardFcn)(0 == iteration);
+        ++iteration;
+
+        isStateMatch = (this->_traceback<Packed>(output) == _endState);
+    }
+
+    ++_tailBitingStats.numFrames;
+    _tailBitingStats.numIterations += iteration;
+    if(isStateMatch) ++_tailBitingStats.numStateMatches;
+}
+
+template <bool Packed>
+unsigned ViterbiDecoder::_traceback(std::uint8_t* output) const
+{
+    const unsigned numStates = _trellis.numStates();
+    const unsigned stateMask = numStates - 1;
+    const unsigned registerBitShift = static_cast<unsigned>(_trellis.K() - 2);
+
+    TracebackBitWriter<Packed> writer(output);
+
+    // Flushed frames output the bits before the tail.
+    unsigned state = _endState;
+    for(size_t step = _numSteps; step > 0; --step)
+    {
+        const unsigned registerBit = state >> registerBitShift;
+        const unsigned decision = _decisions[((step-1) * numStates) + state] & 1;
+        const unsigned prevState = ((state << 1) & stateMask) | decision;
+
+        if((step-1) < _length)
+        {
+            writer.write((step-1), _trellis.inputBit(prevState, registerBit));
+        }
+
+        state = prevState;
+    }
+
+    return state;
+}
+
+template <int K, int FixedN>
+void ViterbiDecoder::_forward(bool isFirstPass)
+{
+    constexpr unsigned numStates = 1U << (K - 1);
+    constexpr unsigned stateMask = numStates - 1;
+    constexpr unsigned registerBitShift = K - 2;
+
+    const int N = (FixedN > 0) ? FixedN : _trellis.N();
+    const size_t numOutputs = 1U << N;
+
+    // Flushed frames start in the zero state. Tail-biting frames can start
+    // in any state, so all states start out equally likely, and later
+    // passes wrap around from where the last one ended.
+    if(isFirstPass)
+    {
+        std::fill(_pathMetrics.begin(), _pathMetrics.end(), (_isTailBiting ? 0 : InvalidPathMetric));
+        _pathMetrics[0] = 0;
+    }
+    else
+    {
+        const auto maxMetric = *std::max_element(_pathMetrics.begin(), _pathMetrics.end());
+        for(auto& metric: _pathMetrics) metric -= maxMetric;
+    }
+
+    for(size_t step = 0; step < _numSteps; ++step)
+    {
+        const auto* symbols = &_depunctured[step * N];
+
+        for(size_t output = 0; output < numOutputs; ++output)
+        {
+            std::int32_t branchMetric = 0;
+            for(int i = 0; i < N; ++i)
+            {
+                branchMetric += ((output >> i) & 1) ? symbols[i] : -symbols[i];
+            }
+            _branchMetrics[output] = branchMetric;
+        }
+
+        auto* decisions = &_decisions[step * numStates];
+
+        // Each state has two predecessors, differing only in the bit that
+        // was shifted out of the register.
+        for(unsigned state = 0; state < numStates; ++state)
+        {
+            const unsigned registerBit = state >> registerBitShift;
+            const unsigned prevState0 = (state << 1) & stateMask;
+            const unsigned prevState1 = prevState0 | 1;
+
+            const auto metric0 = _pathMetrics[prevState0] + _branchMetrics[_trellis.output(prevState0, registerBit)];
+            const auto metric1 = _pathMetrics[prevState1] + _branchMetrics[_trellis.output(prevState1, registerBit)];
+
+            decisions[state] = (metric1 > metric0) ? 1 : 0;
+            _nextPathMetrics[state] = std::max(metric0, metric1);
+        }
+
+        _pathMetrics.swap(_nextPathMetrics);
+
+        if(0 == ((step+1) % NormalizeInterval))
+        {
+            const auto maxMetric = *std::max_element(_pathMetrics.begin(), _pathMetrics.end());
+            for(auto& metric: _pathMetrics) metric -= maxMetric;
+        }
+    }
+
+    // Flushed frames end in the zero state. Otherwise, trace back from the
+    // most likely end state.
+    _endState = 0;
+    if(_isTailBiting)
+    {
+        _endState = static_cast<unsigned>(std::distance(
+                        _pathMetrics.begin(),
+                        std::max_element(_pathMetrics.begin(), _pathMetrics.end())));
+    }
+}
+
+// Predecessors 2k and 2k+1 both lead to states k and k + numStates/2, so
+// each group handles 32 consecutive predecessors and the 16 states in each
+// half of the state space they lead to.
+template <int K>
+void ViterbiDecoder::_forwardVector(bool isFirstPass)
+{
+    constexpr unsigned numStates = 1U << (K - 1);
+    constexpr unsigned numVectors = numStates / NumLanes;
+    constexpr unsigned numGroups = numVectors / 2;
+
+    const int N = _trellis.N();
+
+    const Int16x16 zeros = {0};
+    const Int16x16 invalids = zeros + InvalidVectorPathMetric;
+
+    // Later passes start from the last one's metrics, which are already
+    // normalized.
+    if(isFirstPass)
+    {
+        for(unsigned vec = 0; vec < numVectors; ++vec)
+        {
+            _vectorPathMetrics[vec] = (_isTailBiting ? zeros : invalids);
+        }
+        _vectorPathMetrics[0][0] = 0;
+    }
+
+    Int16x16 symbols[4];
+
+    for(size_t step = 0; step < _numSteps; ++step)
+    {
+        const auto* stepSymbols = &_depunctured[step * N];
+        for(int i = 0; i < N; ++i) symbols[i] = zeros + stepSymbols[i];
+
+        auto* decisions = &_decisions[step * numStates];
+
+        for(unsigned group = 0; group < numGroups; ++group)
+        {
+            Int16x16 evenMetrics, oddMetrics;
+            deinterleave(
+                _vectorPathMetrics[2 * group],
+                _vectorPathMetrics[(2 * group) + 1],
+                evenMetrics,
+                oddMetrics);
+
+            for(unsigned registerBit = 0; registerBit < 2; ++registerBit)
+            {
+                const auto* evenSigns = &_outputSigns[(((group * 2) + registerBit) * 2) * N];
+                const auto* oddSigns = evenSigns + N;
+
+                Int16x16 metric0 = evenMetrics;
+                Int16x16 metric1 = oddMetrics;
+                for(int i = 0; i < N; ++i)
+                {
+                    metric0 += evenSigns[i] * symbols[i];
+                    metric1 += oddSigns[i] * symbols[i];
+                }
+
+                // Each lane is all ones where the odd predecessor won.
+                const Int16x16 decision = (metric1 > metric0);
+
+                const unsigned nextVector = (registerBit * numGroups) + group;
+                _nextVectorPathMetrics[nextVector] = decision ? metric1 : metric0;
+
+                const Int8x16 decisionBytes = __builtin_convertvector(decision, Int8x16);
+                std::memcpy(&decisions[nextVector * NumLanes], &decisionBytes, sizeof(decisionBytes));
+            }
+        }
+
+        const Int16x16 normalization = zeros + _nextVectorPathMetrics[0][0];
+        for(unsigned vec = 0; vec < numVectors; ++vec)
+        {
+            _vectorPathMetrics[vec] = _nextVectorPathMetrics[vec] - normalization;
+        }
+    }
+
+    _endState = 0;
+    if(_isTailBiting)
+    {
+        for(unsigned state = 1; state < numStates; ++state)
+        {
+            if(_vectorPathMetrics[state / NumLanes][state % NumLanes] >
+               _vectorPathMetrics[_endState / NumLanes][_endState % NumLanes])
+            {
+                _endState = state;
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include "ConvCodeConfig.hpp"
+#include "ConvTrellis.hpp"
+#include "ConvolutionUtility.hpp"
+#include "VectorTypes.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// A hard-decision Viterbi decoder for a single code snapshot. All of the
+// trellis, path metric, and traceback memory is allocated on construction,
+// so decoding a frame never allocates.
+//
+// Tail-biting frames are decoded with the wrap-around Viterbi algorithm
+// (WAVA), which repeats the forward pass, starting each from the previous
+// pass's final metrics, until the best path starts and ends in the same
+// state. Most frames converge on the first pass.
+//
+// The forward pass is instantiated for each supported constraint length.
+// Codes with enough states to fill a vector register are vectorized across
+// states, and smaller codes use a scalar loop with a fixed state count,
+// which is also instantiated for each rate the standard codes use.
+class ViterbiDecoder
+{
+public:
+    using UPtr = std::unique_ptr<ViterbiDecoder>;
+
+    explicit ViterbiDecoder(const ConvCodeConfig::SPtr& config);
+
+    inline const ConvCodeConfig::SPtr& config() const
+    {
+        return _config;
+    }
+
+    // Decodes config()->encodedLength() soft bits, where positive values
+    // correspond to 1, into config()->convCode().len hard bits.
+    void decode(const std::int8_t* input, std::uint8_t* output);
+
+    // As above, but outputs the bits MSB-first into
+    // ceil(config()->convCode().len / 8) bytes.
+    void decodePacked(const std::int8_t* input, std::uint8_t* output);
+
+    inline size_t maxTailBitingIterations() const
+    {
+        return _maxTailBitingIterations;
+    }
+
+    // If no pass's best path starts and ends in the same state, the last
+    // pass's best path is output.
+    void setMaxTailBitingIterations(size_t maxTailBitingIterations);
+
+    // Returns the totals since the last call.
+    TailBitingStats takeTailBitingStats();
+
+private:
+    using ForwardFcn = void(ViterbiDecoder::*)(bool);
+
+    ConvCodeConfig::SPtr _config;
+    ConvTrellis _trellis;
+
+    size_t _length;
+    bool _isTailBiting;
+
+    // The steps in one forward pass, which includes the tail of a flushed
+    // frame
+    size_t _numSteps;
+
+    size_t _maxTailBitingIterations;
+    TailBitingStats _tailBitingStats;
+
+    // For each unpunctured position, the index of the input bit, or -1
+    // if it was punctured.
+    std::vector<int> _depunctureMap;
+    std::vector<std::int16_t> _depunctured;
+
+    ForwardFcn _forwardFcn;
+
+    // Used by the scalar forward pass
+    std::vector<std::int32_t> _branchMetrics;
+    std::vector<std::int32_t> _pathMetrics;
+    std::vector<std::int32_t> _nextPathMetrics;
+
+    // Used by the vectorized forward pass. For each group of 16 butterflies,
+    // each register bit, and each predecessor parity, the sign each output
+    // contributes to the branch metric of each state.
+    AlignedArray<Int16x16> _outputSigns;
+    AlignedArray<Int16x16> _vectorPathMetrics;
+    AlignedArray<Int16x16> _nextVectorPathMetrics;
+
+    // One byte per state per step, where the low bit is set if the odd
+    // predecessor was chosen.
+    std::vector<std::uint8_t> _decisions;
+
+    unsigned _endState;
+
+    template <bool Packed>
+    void _decode(const std::int8_t* input, std::uint8_t* output);
+
+    // Returns the state the traced path starts in.
+    template <bool Packed>
+    unsigned _traceback(std::uint8_t* output) const;
+
+    // Each pass after the first starts from the previous pass's final
+    // metrics, which is only done for tail-biting frames.
+    //
+    // FixedN is 0 to read the code's rate at runtime.
+    template <int K, int FixedN>
+    void _forward(bool isFirstPass);
+
+    template <int K>
+    void _forwardVector(bool isFirstPass);
+};
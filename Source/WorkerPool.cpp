@@ -0,0 +1,129 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+struct WorkerPool::Job
+{
+    Job(const std::function<void(size_t)>& task, size_t numTasks):
+        task(task),
+        numTasks(numTasks),
+        nextIndex(0),
+        numFinished(0)
+    {}
+
+    const std::function<void(size_t)>& task;
+    const size_t numTasks;
+    std::atomic<size_t> nextIndex;
+
+    // Guarded by mutex
+    size_t numFinished;
+    std::exception_ptr exception;
+
+    std::mutex mutex;
+    std::condition_variable finished;
+};
+
+WorkerPool& WorkerPool::global()
+{
+    // The calling thread makes up the last core.
+    static WorkerPool pool(std::max<size_t>(std::thread::hardware_concurrency(), 1) - 1);
+
+    return pool;
+}
+
+WorkerPool::WorkerPool(size_t numWorkers):
+    _isStopping(false)
+{
+    for(size_t worker = 0; worker < numWorkers; ++worker)
+    {
+        _workers.emplace_back(&WorkerPool::_workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _jobQueued.notify_all();
+
+    for(auto& worker: _workers) worker.join();
+}
+
+void WorkerPool::parallelFor(size_t numTasks, const std::function<void(size_t)>& task)
+{
+    if((numTasks < 2) || _workers.empty())
+    {
+        for(size_t index = 0; index < numTasks; ++index) task(index);
+        return;
+    }
+
+    auto job = std::make_shared<Job>(task, numTasks);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _jobs.push_back(job);
+    }
+    _jobQueued.notify_all();
+
+    while(_runTask(*job)) {}
+
+    // Every task has been started, so workers no longer need to find the
+    // job, but they may still be running some of its tasks.
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto iter = std::find(_jobs.begin(), _jobs.end(), job);
+        if(iter != _jobs.end()) _jobs.erase(iter);
+    }
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->finished.wait(lock, [&job]() { return job->numFinished == job->numTasks; });
+
+    if(job->exception) std::rethrow_exception(job->exception);
+}
+
+void WorkerPool::_workerLoop()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while(true)
+    {
+        _jobQueued.wait(lock, [this]() { return _isStopping || !_jobs.empty(); });
+        if(_isStopping) return;
+
+        auto job = _jobs.front();
+
+        lock.unlock();
+        const bool ranTask = _runTask(*job);
+        lock.lock();
+
+        if(!ranTask && !_jobs.empty() && (_jobs.front() == job)) _jobs.pop_front();
+    }
+}
+
+bool WorkerPool::_runTask(Job& job)
+{
+    const size_t index = job.nextIndex++;
+    if(index >= job.numTasks) return false;
+
+    std::exception_ptr exception;
+    try
+    {
+        job.task(index);
+    }
+    catch(...)
+    {
+        exception = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(job.mutex);
+    if(exception && !job.exception) job.exception = exception;
+    if(++job.numFinished == job.numTasks) job.finished.notify_all();
+
+    return true;
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2020 Nicholas Corgan
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A process-wide pool of worker threads, shared by every block that splits
+// independent pieces of its work, such as the code blocks of a transport
+// block, across cores.
+//
+// The calling thread runs tasks alongside the workers, so a call always
+// makes progress, even when every worker is busy with another block's work.
+class WorkerPool
+{
+public:
+    static WorkerPool& global();
+
+    // Starts the given number of workers, which may be 0.
+    explicit WorkerPool(size_t numWorkers);
+
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    inline size_t numWorkers() const
+    {
+        return _workers.size();
+    }
+
+    // Calls task(index) for each index in [0, numTasks) and returns once
+    // all calls have. If any call throws, the first exception is rethrown
+    // after the rest have finished.
+    void parallelFor(size_t numTasks, const std::function<void(size_t)>& task);
+
+private:
+    struct Job;
+
+    std::vector<std::thread> _workers;
+
+    std::mutex _mutex;
+    std::condition_variable _jobQueued;
+    std::deque<std::shared_ptr<Job>> _jobs;
+    bool _isStopping;
+
+    void _workerLoop();
+
+    // Returns false if every task in the job has already been started.
+    static bool _runTask(Job& job);
+};
@@ -3,6 +3,11 @@
 
 #include "TestUtility.hpp"
 
+extern "C"
+{
+#include <turbofec/conv.h>
+}
+
 #include <Pothos/Framework.hpp>
 #include <Pothos/Proxy.hpp>
 #include <Pothos/Testing.hpp>
@@ -10,6 +15,9 @@
 #include <Poco/Format.h>
 #include <Poco/String.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -370,7 +378,7 @@ POTHOS_TEST_BLOCK("/fec/tests", test_standard_conv_coder_symmetry)
 static void testGenericConvCoderSetter(const Pothos::Proxy& convCoder)
 {
     static const std::vector<int> validN = {2,3,4};
-    static const std::vector<int> validK = {5,7};
+    static const std::vector<int> validK = {3,4,5,6,7,8,9};
     constexpr size_t testLength = 128;
     constexpr unsigned testRGen = 037;
     static const std::vector<unsigned> testGen = {0100, 0145, 0175, 020};
@@ -434,3 +442,810 @@ POTHOS_TEST_BLOCK("/fec/tests", test_generic_conv_default_params)
     testCodersAndGetBER(encoder, decoder, &ber);
     std::cout << ber << std::endl;
 }
+
+POTHOS_TEST_BLOCK("/fec/tests", test_generic_conv_constraint_lengths)
+{
+    // Rate 1/2 codes with maximum free distance for each constraint length
+    static const std::vector<std::vector<unsigned>> gens =
+    {
+        {05, 07},
+        {015, 017},
+        {023, 035},
+        {053, 075},
+        {0133, 0171},
+        {0247, 0371},
+        {0561, 0753}
+    };
+    static const std::vector<std::string> termTypes = {"Flush", "Tail-biting"};
+
+    for(const auto& gen: gens)
+    {
+        const int K = 32 - __builtin_clz(gen.back());
+
+        for(const auto& termType: termTypes)
+        {
+            std::cout << " * Testing K=" << K << " (" << termType << ")..." << std::endl;
+
+            auto encoder = Pothos::BlockRegistry::make("/fec/generic_conv_encoder");
+            auto decoder = Pothos::BlockRegistry::make("/fec/generic_conv_decoder");
+            for(const auto& coder: {encoder, decoder})
+            {
+                coder.call("setK", K);
+                coder.call("setGen", gen);
+                coder.call("setTerminationType", termType);
+            }
+
+            double ber = 0.0;
+            testCodersAndGetBER(encoder, decoder, &ber);
+            POTHOS_TEST_LT(ber, 1e-3);
+        }
+
+        // Make the code recursive systematic, which requires flushing.
+        std::cout << " * Testing K=" << K << " (recursive)..." << std::endl;
+
+        auto encoder = Pothos::BlockRegistry::make("/fec/generic_conv_encoder");
+        auto decoder = Pothos::BlockRegistry::make("/fec/generic_conv_decoder");
+        const std::vector<unsigned> recursiveGen = {(1U << (K-1)), gen.back()};
+        for(const auto& coder: {encoder, decoder})
+        {
+            coder.call("setK", K);
+            coder.call("setGen", recursiveGen);
+            coder.call("setTerminationType", "Flush");
+            coder.call("setRGen", gen.front());
+        }
+
+        double ber = 0.0;
+        testCodersAndGetBER(encoder, decoder, &ber);
+        POTHOS_TEST_LT(ber, 1e-3);
+    }
+}
+
+//
+// Test that processing multiple frames per work() call doesn't affect output
+//
+
+static Pothos::BufferChunk getCoderOutput(
+    const Pothos::Proxy& coder,
+    const Pothos::BufferChunk& input)
+{
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", input.dtype);
+    feederSource.call("feedBuffer", input);
+
+    const auto outputDType = coder.call("output", 0).call("dtype").call<std::string>("name");
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", outputDType);
+
+    {
+        Pothos::Topology topology;
+
+        topology.connect(feederSource, 0, coder, 0);
+        topology.connect(coder, 0, collectorSink, 0);
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+    }
+
+    return collectorSink.call<Pothos::BufferChunk>("getBuffer");
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_conv_max_frames_per_work)
+{
+    constexpr size_t numFrames = 100;
+    static const std::vector<size_t> maxFramesPerWorkValues = {1, 7, 64, 1000};
+
+    auto encoder = Pothos::BlockRegistry::make("/fec/gsm_xcch_encoder");
+    const auto length = encoder.call<size_t>("length");
+    const auto randomInput = FECTests::getRandomInput(length * numFrames, true /*asBits*/);
+
+    Pothos::BufferChunk expectedOutput;
+    for(size_t maxFramesPerWork: maxFramesPerWorkValues)
+    {
+        std::cout << " * Testing " << maxFramesPerWork << " max frames per work..." << std::endl;
+
+        encoder.call("setMaxFramesPerWork", maxFramesPerWork);
+        POTHOS_TEST_EQUAL(maxFramesPerWork, encoder.call<size_t>("maxFramesPerWork"));
+
+        const auto output = getCoderOutput(encoder, randomInput);
+        POTHOS_TEST_EQUAL(0, (output.elements() % numFrames));
+
+        if(0 == expectedOutput.elements()) expectedOutput = output;
+        else
+        {
+            POTHOS_TEST_EQUAL(expectedOutput.elements(), output.elements());
+            POTHOS_TEST_EQUALA(
+                expectedOutput.as<const std::uint8_t*>(),
+                output.as<const std::uint8_t*>(),
+                output.elements());
+        }
+    }
+
+    POTHOS_TEST_THROWS(
+        encoder.call("setMaxFramesPerWork", 0),
+        Pothos::ProxyExceptionMessage);
+}
+
+//
+// Test that the calculated encoded length matches the encoder's output
+//
+
+POTHOS_TEST_BLOCK("/fec/tests", test_conv_encoded_length)
+{
+    constexpr size_t numFrames = 4;
+
+    for(const auto& standardName: StandardNames)
+    {
+        std::cout << " * Testing " << standardName << "..." << std::endl;
+
+        auto encoder = Pothos::BlockRegistry::make(Poco::format("/fec/%s_encoder", convertStandardName(standardName)));
+        auto decoder = Pothos::BlockRegistry::make(Poco::format("/fec/%s_decoder", convertStandardName(standardName)));
+        POTHOS_TEST_EQUAL(
+            encoder.call<int>("encodedLength"),
+            decoder.call<int>("encodedLength"));
+
+        const auto length = encoder.call<size_t>("length");
+        const auto encodedLength = encoder.call<size_t>("encodedLength");
+
+        const auto output = getCoderOutput(
+                                encoder,
+                                FECTests::getRandomInput(length * numFrames, true /*asBits*/));
+        POTHOS_TEST_EQUAL(encodedLength * numFrames, output.elements());
+    }
+
+    // Make sure the generic blocks update the value when their fields change.
+    auto genericEncoder = Pothos::BlockRegistry::make("/fec/generic_conv_encoder");
+    POTHOS_TEST_EQUAL(2 * (224 + 4), genericEncoder.call<int>("encodedLength"));
+
+    genericEncoder.call("setTerminationType", "Tail-biting");
+    POTHOS_TEST_EQUAL(2 * 224, genericEncoder.call<int>("encodedLength"));
+
+    genericEncoder.call("setPuncture", std::vector<int>{1, 3, 5});
+    POTHOS_TEST_EQUAL((2 * 224) - 3, genericEncoder.call<int>("encodedLength"));
+}
+
+//
+// Test that decoders pick up changes to the code between runs
+//
+
+POTHOS_TEST_BLOCK("/fec/tests", test_generic_conv_reconfigure)
+{
+    auto encoder = Pothos::BlockRegistry::make("/fec/generic_conv_encoder");
+    auto decoder = Pothos::BlockRegistry::make("/fec/generic_conv_decoder");
+    double ber = 0.0;
+
+    testCodersAndGetBER(encoder, decoder, &ber);
+    POTHOS_TEST_LT(ber, 1e-3);
+
+    // Switch to the LTE PBCH code.
+    const std::vector<unsigned> gen{0133, 0171, 0165};
+    for(const auto& coder: {encoder, decoder})
+    {
+        coder.call("setN", 3);
+        coder.call("setK", 7);
+        coder.call("setLength", 512);
+        coder.call("setGen", gen);
+        coder.call("setTerminationType", "Tail-biting");
+    }
+
+    testCodersAndGetBER(encoder, decoder, &ber);
+    POTHOS_TEST_LT(ber, 1e-3);
+}
+
+//
+// Test that decoding frames in parallel matches decoding them one at a time
+//
+
+POTHOS_TEST_BLOCK("/fec/tests", test_conv_multi_frame_decoding)
+{
+    constexpr size_t numFrames = 100;
+    static const std::vector<std::string> standardNames = {"GSM XCCH", "GSM TCH-AFS12.2", "LTE PBCH"};
+
+    for(const auto& standardName: standardNames)
+    {
+        std::cout << " * Testing " << standardName << "..." << std::endl;
+
+        auto encoder = Pothos::BlockRegistry::make(Poco::format("/fec/%s_encoder", convertStandardName(standardName)));
+        auto decoder = Pothos::BlockRegistry::make(Poco::format("/fec/%s_decoder", convertStandardName(standardName)));
+
+        const auto length = encoder.call<size_t>("length");
+        const auto encodedValues = getCoderOutput(
+                                       encoder,
+                                       FECTests::getRandomInput(length * numFrames, true /*asBits*/));
+
+        int numBitsChanged = 0;
+        const auto noisyEncodedValues = FECTests::addNoiseAndGetError(
+                                            encodedValues,
+                                            FECTests::defaultSNR,
+                                            FECTests::defaultAmp,
+                                            &numBitsChanged);
+
+        // One frame per work() call can only use the single-frame decoder.
+        decoder.call("setMaxFramesPerWork", 1);
+        const auto singleFrameOutput = getCoderOutput(decoder, noisyEncodedValues);
+
+        decoder.call("setMaxFramesPerWork", numFrames);
+        const auto multiFrameOutput = getCoderOutput(decoder, noisyEncodedValues);
+
+        POTHOS_TEST_EQUAL(length * numFrames, singleFrameOutput.elements());
+        POTHOS_TEST_EQUAL(length * numFrames, multiFrameOutput.elements());
+        POTHOS_TEST_EQUALA(
+            singleFrameOutput.as<const std::uint8_t*>(),
+            multiFrameOutput.as<const std::uint8_t*>(),
+            singleFrameOutput.elements());
+    }
+}
+
+//
+// Test that tail-biting frames stop decoding once their paths converge
+//
+
+POTHOS_TEST_BLOCK("/fec/tests", test_conv_tail_biting_iterations)
+{
+    constexpr size_t numFrames = 100;
+
+    auto encoder = Pothos::BlockRegistry::make("/fec/lte_pbch_encoder");
+    auto decoder = Pothos::BlockRegistry::make("/fec/lte_pbch_decoder");
+
+    POTHOS_TEST_EQUAL(4, decoder.call<size_t>("maxTailBitingIterations"));
+    POTHOS_TEST_EQUAL(0.0, decoder.call<double>("stateMatchRate"));
+    POTHOS_TEST_EQUAL(0.0, decoder.call<double>("averageIterations"));
+
+    const auto length = encoder.call<size_t>("length");
+    const auto input = FECTests::getRandomInput(length * numFrames, true /*asBits*/);
+    const auto encodedValues = getCoderOutput(encoder, input);
+
+    int numBitsChanged = 0;
+    const auto noisyEncodedValues = FECTests::addNoiseAndGetError(
+                                        encodedValues,
+                                        FECTests::defaultSNR,
+                                        FECTests::defaultAmp,
+                                        &numBitsChanged);
+
+    // At this SNR, nearly every frame's path should converge on the first
+    // pass, whether decoded alone or alongside other frames.
+    for(size_t maxFramesPerWork: {size_t(1), numFrames})
+    {
+        decoder.call("setMaxFramesPerWork", maxFramesPerWork);
+
+        const auto output = getCoderOutput(decoder, noisyEncodedValues);
+        POTHOS_TEST_EQUAL(length * numFrames, output.elements());
+
+        const auto stateMatchRate = decoder.call<double>("stateMatchRate");
+        const auto averageIterations = decoder.call<double>("averageIterations");
+        POTHOS_TEST_GE(stateMatchRate, 0.9);
+        POTHOS_TEST_LE(stateMatchRate, 1.0);
+        POTHOS_TEST_GE(averageIterations, 1.0);
+        POTHOS_TEST_LT(averageIterations, 1.5);
+    }
+
+    // With a single pass, no frames can take more.
+    decoder.call("setMaxTailBitingIterations", 1);
+    POTHOS_TEST_EQUAL(1, decoder.call<size_t>("maxTailBitingIterations"));
+
+    const auto output = getCoderOutput(decoder, noisyEncodedValues);
+    POTHOS_TEST_EQUAL(length * numFrames, output.elements());
+    POTHOS_TEST_EQUAL(1.0, decoder.call<double>("averageIterations"));
+
+    POTHOS_TEST_THROWS(
+        decoder.call("setMaxTailBitingIterations", 0),
+        Pothos::ProxyExceptionMessage);
+}
+
+//
+// Test that soft decoders' LLRs agree with the hard decoders and each other
+//
+
+static void testSoftDecoders(
+    const Pothos::Proxy& encoder,
+    const Pothos::Proxy& int8SoftDecoder,
+    const Pothos::Proxy& floatSoftDecoder)
+{
+    constexpr size_t numFrames = 40;
+
+    const auto length = encoder.call<size_t>("length");
+    const auto input = FECTests::getRandomInput(length * numFrames, true /*asBits*/);
+    const auto encodedValues = getCoderOutput(encoder, input);
+
+    int numBitsChanged = 0;
+    const auto noisyEncodedValues = FECTests::addNoiseAndGetError(
+                                        encodedValues,
+                                        FECTests::defaultSNR,
+                                        FECTests::defaultAmp,
+                                        &numBitsChanged);
+
+    const auto int8Output = getCoderOutput(int8SoftDecoder, noisyEncodedValues);
+    const auto floatOutput = getCoderOutput(floatSoftDecoder, noisyEncodedValues);
+    POTHOS_TEST_EQUAL(length * numFrames, int8Output.elements());
+    POTHOS_TEST_EQUAL(length * numFrames, floatOutput.elements());
+
+    const auto* inputBits = input.as<const std::uint8_t*>();
+    const auto* int8LLRs = int8Output.as<const std::int8_t*>();
+    const auto* floatLLRs = floatOutput.as<const float*>();
+
+    size_t numErrors = 0;
+    for(size_t i = 0; i < (length * numFrames); ++i)
+    {
+        const auto saturatedLLR = std::max(-127.0f, std::min(127.0f, floatLLRs[i]));
+        POTHOS_TEST_EQUAL(static_cast<int>(saturatedLLR), static_cast<int>(int8LLRs[i]));
+
+        if((floatLLRs[i] > 0.0f) != (inputBits[i] != 0)) ++numErrors;
+    }
+
+    const double ber = double(numErrors) / double(length * numFrames);
+    POTHOS_TEST_LT(ber, 1e-3);
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_conv_soft_decoding)
+{
+    for(const auto& standardName: StandardNames)
+    {
+        std::cout << " * Testing " << standardName << "..." << std::endl;
+
+        const auto convertedStandardName = convertStandardName(standardName);
+        testSoftDecoders(
+            Pothos::BlockRegistry::make(Poco::format("/fec/%s_encoder", convertedStandardName)),
+            Pothos::BlockRegistry::make(Poco::format("/fec/%s_soft_decoder", convertedStandardName), "int8"),
+            Pothos::BlockRegistry::make(Poco::format("/fec/%s_soft_decoder", convertedStandardName), "float32"));
+    }
+
+    std::cout << " * Testing generic (tail-biting, K=9)..." << std::endl;
+
+    auto encoder = Pothos::BlockRegistry::make("/fec/generic_conv_encoder");
+    auto int8SoftDecoder = Pothos::BlockRegistry::make("/fec/generic_conv_soft_decoder", "int8");
+    auto floatSoftDecoder = Pothos::BlockRegistry::make("/fec/generic_conv_soft_decoder", "float32");
+    for(const auto& coder: {encoder, int8SoftDecoder, floatSoftDecoder})
+    {
+        coder.call("setK", 9);
+        coder.call("setGen", std::vector<unsigned>{0561, 0753});
+        coder.call("setTerminationType", "Tail-biting");
+    }
+
+    testSoftDecoders(encoder, int8SoftDecoder, floatSoftDecoder);
+}
+
+//
+// Test that packed coders match unpacked coders
+//
+
+static Pothos::BufferChunk packBits(const Pothos::BufferChunk& bits, size_t frameLength)
+{
+    const size_t packedFrameLength = (frameLength + 7) / 8;
+    const size_t numFrames = bits.elements() / frameLength;
+
+    Pothos::BufferChunk packed("uint8", numFrames * packedFrameLength);
+    std::memset(packed.as<void*>(), 0, packed.length);
+
+    const auto* bitsBuff = bits.as<const std::uint8_t*>();
+    auto* packedBuff = packed.as<std::uint8_t*>();
+
+    for(size_t frame = 0; frame < numFrames; ++frame)
+    {
+        for(size_t bit = 0; bit < frameLength; ++bit)
+        {
+            if(bitsBuff[(frame * frameLength) + bit])
+            {
+                packedBuff[(frame * packedFrameLength) + (bit / 8)] |= (1 << (7 - (bit % 8)));
+            }
+        }
+    }
+
+    return packed;
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_conv_packed)
+{
+    constexpr size_t numFrames = 40;
+    static const std::vector<std::string> standardNames = {"GSM XCCH", "GSM RACH", "GSM TCH-HR", "LTE PBCH"};
+
+    for(const auto& standardName: standardNames)
+    {
+        std::cout << " * Testing " << standardName << "..." << std::endl;
+
+        auto encoder = Pothos::BlockRegistry::make(Poco::format("/fec/%s_encoder", convertStandardName(standardName)));
+        auto decoder = Pothos::BlockRegistry::make(Poco::format("/fec/%s_decoder", convertStandardName(standardName)));
+
+        const auto length = encoder.call<size_t>("length");
+        const auto input = FECTests::getRandomInput(length * numFrames, true /*asBits*/);
+
+        const auto encodedValues = getCoderOutput(encoder, input);
+        encoder.call("setPacked", true);
+        POTHOS_TEST_TRUE(encoder.call<bool>("packed"));
+        const auto packedEncodedValues = getCoderOutput(encoder, packBits(input, length));
+
+        POTHOS_TEST_EQUAL(encodedValues.elements(), packedEncodedValues.elements());
+        POTHOS_TEST_EQUALA(
+            encodedValues.as<const std::uint8_t*>(),
+            packedEncodedValues.as<const std::uint8_t*>(),
+            encodedValues.elements());
+
+        int numBitsChanged = 0;
+        const auto noisyEncodedValues = FECTests::addNoiseAndGetError(
+                                            encodedValues,
+                                            FECTests::defaultSNR,
+                                            FECTests::defaultAmp,
+                                            &numBitsChanged);
+
+        const auto expectedPackedOutput = packBits(getCoderOutput(decoder, noisyEncodedValues), length);
+        decoder.call("setPacked", true);
+        const auto packedOutput = getCoderOutput(decoder, noisyEncodedValues);
+
+        POTHOS_TEST_EQUAL(expectedPackedOutput.elements(), packedOutput.elements());
+        POTHOS_TEST_EQUALA(
+            expectedPackedOutput.as<const std::uint8_t*>(),
+            packedOutput.as<const std::uint8_t*>(),
+            expectedPackedOutput.elements());
+    }
+
+    auto softDecoder = Pothos::BlockRegistry::make("/fec/generic_conv_soft_decoder", "float32");
+    POTHOS_TEST_THROWS(
+        softDecoder.call("setPacked", true),
+        Pothos::ProxyExceptionMessage);
+}
+
+//
+// Test that the in-tree encoder matches TurboFEC
+//
+
+static void testEncoderMatchesTurboFEC(const Pothos::Proxy& encoder)
+{
+    constexpr size_t numFrames = 20;
+
+    const auto gen = encoder.call<std::vector<unsigned>>("gen");
+    auto puncture = encoder.call<std::vector<int>>("puncture");
+    if(!puncture.empty()) puncture.emplace_back(-1);
+
+    lte_conv_code convCode;
+    std::memset(&convCode, 0, sizeof(convCode));
+    convCode.n = encoder.call<int>("N");
+    convCode.k = encoder.call<int>("K");
+    convCode.len = encoder.call<int>("length");
+    convCode.rgen = encoder.call<unsigned>("rgen");
+    std::copy(gen.begin(), gen.end(), convCode.gen);
+    convCode.punc = puncture.empty() ? nullptr : puncture.data();
+    convCode.term = ("Flush" == encoder.call<std::string>("terminationType")) ? CONV_TERM_FLUSH : CONV_TERM_TAIL_BITING;
+
+    const auto length = static_cast<size_t>(convCode.len);
+    const auto encodedLength = encoder.call<size_t>("encodedLength");
+
+    const auto input = FECTests::getRandomInput(length * numFrames, true /*asBits*/);
+    const auto output = getCoderOutput(encoder, input);
+    POTHOS_TEST_EQUAL(encodedLength * numFrames, output.elements());
+
+    std::vector<std::uint8_t> expectedOutput(encodedLength);
+    for(size_t frame = 0; frame < numFrames; ++frame)
+    {
+        POTHOS_TEST_EQUAL(
+            static_cast<int>(encodedLength),
+            lte_conv_encode(
+                &convCode,
+                input.as<const std::uint8_t*>() + (frame * length),
+                expectedOutput.data()));
+        POTHOS_TEST_EQUALA(
+            expectedOutput.data(),
+            output.as<const std::uint8_t*>() + (frame * encodedLength),
+            encodedLength);
+    }
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_conv_encoder_matches_turbofec)
+{
+    for(const auto& standardName: StandardNames)
+    {
+        std::cout << " * Testing " << standardName << "..." << std::endl;
+
+        testEncoderMatchesTurboFEC(Pothos::BlockRegistry::make(
+            Poco::format("/fec/%s_encoder", convertStandardName(standardName))));
+    }
+
+    // Cover lengths that aren't a whole number of bytes with both
+    // termination types.
+    for(const auto& termType: {"Flush", "Tail-biting"})
+    {
+        std::cout << " * Testing generic (" << termType << ")..." << std::endl;
+
+        auto encoder = Pothos::BlockRegistry::make("/fec/generic_conv_encoder");
+        encoder.call("setN", 3);
+        encoder.call("setK", 7);
+        encoder.call("setGen", std::vector<unsigned>{0133, 0171, 0165});
+        encoder.call("setLength", 61);
+        encoder.call("setTerminationType", std::string(termType));
+
+        testEncoderMatchesTurboFEC(encoder);
+    }
+}
+
+//
+// Test that label-delimited frames can each have their own length
+//
+
+static Pothos::BufferChunk getCoderOutput(
+    const Pothos::Proxy& coder,
+    const Pothos::BufferChunk& input,
+    const std::vector<Pothos::Label>& inputLabels,
+    std::vector<Pothos::Label>* outputLabelsOut)
+{
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", input.dtype);
+    feederSource.call("feedBuffer", input);
+    for(const auto& label: inputLabels) feederSource.call("feedLabel", label);
+
+    const auto outputDType = coder.call("output", 0).call("dtype").call<std::string>("name");
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", outputDType);
+
+    {
+        Pothos::Topology topology;
+
+        topology.connect(feederSource, 0, coder, 0);
+        topology.connect(coder, 0, collectorSink, 0);
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+    }
+
+    *outputLabelsOut = collectorSink.call<std::vector<Pothos::Label>>("getLabels");
+
+    return collectorSink.call<Pothos::BufferChunk>("getBuffer");
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_conv_block_start_id)
+{
+    const std::string blockStartID = "START";
+    static const std::vector<size_t> frameLengths = {224, 37, 100, 61};
+    constexpr size_t numJunkElems = 13;
+
+    auto encoder = Pothos::BlockRegistry::make("/fec/generic_conv_encoder");
+    auto decoder = Pothos::BlockRegistry::make("/fec/generic_conv_decoder");
+    for(const auto& coder: {encoder, decoder})
+    {
+        coder.call("setBlockStartID", blockStartID);
+        POTHOS_TEST_EQUAL(blockStartID, coder.call<std::string>("blockStartID"));
+    }
+
+    // Each frame follows some data that isn't part of any frame, which
+    // should be dropped.
+    size_t numInputElems = 0;
+    std::vector<Pothos::Label> inputLabels;
+    for(size_t frameLength: frameLengths)
+    {
+        numInputElems += numJunkElems;
+        inputLabels.emplace_back(blockStartID, frameLength, numInputElems);
+        numInputElems += frameLength;
+    }
+    const auto input = FECTests::getRandomInput(numInputElems, true /*asBits*/);
+
+    std::vector<Pothos::Label> encodedLabels;
+    const auto encodedValues = getCoderOutput(encoder, input, inputLabels, &encodedLabels);
+    POTHOS_TEST_EQUAL(frameLengths.size(), encodedLabels.size());
+
+    // With the default code, each encoded frame is 2*(length+4) bits.
+    size_t encodedIndex = 0;
+    for(size_t frame = 0; frame < frameLengths.size(); ++frame)
+    {
+        const auto encodedLength = 2 * (frameLengths[frame] + 4);
+
+        FECTests::testLabelsEqual(
+            Pothos::Label(blockStartID, encodedLength, encodedIndex),
+            encodedLabels[frame]);
+        encodedIndex += encodedLength;
+    }
+    POTHOS_TEST_EQUAL(encodedIndex, encodedValues.elements());
+
+    Pothos::BufferChunk softValues("int8", encodedValues.elements());
+    for(size_t elem = 0; elem < encodedValues.elements(); ++elem)
+    {
+        softValues.as<std::int8_t*>()[elem] = encodedValues.as<const std::uint8_t*>()[elem] ? 64 : -64;
+    }
+
+    std::vector<Pothos::Label> decodedLabels;
+    const auto decodedValues = getCoderOutput(decoder, softValues, encodedLabels, &decodedLabels);
+    POTHOS_TEST_EQUAL(frameLengths.size(), decodedLabels.size());
+
+    size_t decodedIndex = 0;
+    for(size_t frame = 0; frame < frameLengths.size(); ++frame)
+    {
+        const auto frameLength = frameLengths[frame];
+
+        FECTests::testLabelsEqual(
+            Pothos::Label(blockStartID, frameLength, decodedIndex),
+            decodedLabels[frame]);
+        POTHOS_TEST_EQUALA(
+            input.as<const std::uint8_t*>() + inputLabels[frame].index,
+            decodedValues.as<const std::uint8_t*>() + decodedIndex,
+            frameLength);
+
+        decodedIndex += frameLength;
+    }
+    POTHOS_TEST_EQUAL(decodedIndex, decodedValues.elements());
+}
+
+//
+// Test that the GSM AMR coders switch codec modes at labels
+//
+
+POTHOS_TEST_BLOCK("/fec/tests", test_gsm_amr_mode_switching)
+{
+    const std::string modeLabelID = "AMR_MODE";
+
+    struct ModeRun
+    {
+        unsigned mode;
+        std::string modeName;
+        size_t numFrames;
+    };
+
+    // Enough consecutive frames in one run to be decoded in parallel, and
+    // a run that starts partway through the previous run's last frame.
+    static const std::vector<ModeRun> modeRuns =
+    {
+        {5, "7.95", 3},
+        {0, "4.75", 1},
+        {3, "6.7", 20},
+        {5, "7.95", 2},
+        {1, "5.15", 1},
+    };
+    constexpr size_t numJunkElems = 17;
+    constexpr size_t junkRunIndex = 3;
+
+    auto encoder = Pothos::BlockRegistry::make("/fec/gsm_amr_encoder", "AHS");
+    auto decoder = Pothos::BlockRegistry::make("/fec/gsm_amr_decoder", "AHS");
+    POTHOS_TEST_EQUAL(
+        std::vector<unsigned>({0, 1, 2, 3, 4, 5}),
+        encoder.call<std::vector<unsigned>>("modes"));
+
+    // Both channels start at 7.95.
+    POTHOS_TEST_EQUAL(5U, encoder.call<unsigned>("mode"));
+    POTHOS_TEST_EQUAL(5U, decoder.call<unsigned>("mode"));
+    POTHOS_TEST_EQUAL(
+        5U,
+        Pothos::BlockRegistry::make("/fec/gsm_amr_encoder", "AFS").call<unsigned>("mode"));
+
+    // Build the encoder input and each mode's expected output from the
+    // single-mode encoders.
+    std::vector<Pothos::Label> inputLabels;
+    std::vector<Pothos::BufferChunk> inputRuns;
+    std::vector<Pothos::BufferChunk> expectedRuns;
+    size_t numInputElems = 0;
+    size_t numEncodedElems = 0;
+    size_t numDecodedElems = 0;
+    for(size_t run = 0; run < modeRuns.size(); ++run)
+    {
+        const auto& modeRun = modeRuns[run];
+        const auto length = encoder.call<size_t>("length", modeRun.mode);
+        const auto encodedLength = encoder.call<size_t>("encodedLength", modeRun.mode);
+
+        // This data is an incomplete frame and should be dropped.
+        if(run == junkRunIndex)
+        {
+            inputRuns.emplace_back(FECTests::getRandomInput(numJunkElems, true /*asBits*/));
+            numInputElems += numJunkElems;
+        }
+
+        inputLabels.emplace_back(modeLabelID, modeRun.mode, numInputElems);
+        inputRuns.emplace_back(FECTests::getRandomInput(length * modeRun.numFrames, true /*asBits*/));
+        numInputElems += inputRuns.back().elements();
+
+        auto modeEncoder = Pothos::BlockRegistry::make(
+                               "/fec/"+convertStandardName("GSM TCH-AHS"+modeRun.modeName)+"_encoder");
+        expectedRuns.emplace_back(getCoderOutput(modeEncoder, inputRuns.back()));
+        POTHOS_TEST_EQUAL(encodedLength * modeRun.numFrames, expectedRuns.back().elements());
+
+        numEncodedElems += expectedRuns.back().elements();
+        numDecodedElems += length * modeRun.numFrames;
+    }
+
+    Pothos::BufferChunk input("uint8", numInputElems);
+    size_t inputIndex = 0;
+    for(const auto& inputRun: inputRuns)
+    {
+        std::memcpy(input.as<std::uint8_t*>() + inputIndex, inputRun.as<const void*>(), inputRun.elements());
+        inputIndex += inputRun.elements();
+    }
+
+    std::vector<Pothos::Label> encodedLabels;
+    const auto encodedValues = getCoderOutput(encoder, input, inputLabels, &encodedLabels);
+    POTHOS_TEST_EQUAL(numEncodedElems, encodedValues.elements());
+    POTHOS_TEST_EQUAL(modeRuns.size(), encodedLabels.size());
+
+    size_t encodedIndex = 0;
+    for(size_t run = 0; run < modeRuns.size(); ++run)
+    {
+        FECTests::testLabelsEqual(
+            Pothos::Label(modeLabelID, modeRuns[run].mode, encodedIndex),
+            encodedLabels[run]);
+        POTHOS_TEST_EQUALA(
+            expectedRuns[run].as<const std::uint8_t*>(),
+            encodedValues.as<const std::uint8_t*>() + encodedIndex,
+            expectedRuns[run].elements());
+
+        encodedIndex += expectedRuns[run].elements();
+    }
+
+    Pothos::BufferChunk softValues("int8", encodedValues.elements());
+    for(size_t elem = 0; elem < encodedValues.elements(); ++elem)
+    {
+        softValues.as<std::int8_t*>()[elem] = encodedValues.as<const std::uint8_t*>()[elem] ? 64 : -64;
+    }
+
+    std::vector<Pothos::Label> decodedLabels;
+    const auto decodedValues = getCoderOutput(decoder, softValues, encodedLabels, &decodedLabels);
+    POTHOS_TEST_EQUAL(numDecodedElems, decodedValues.elements());
+    POTHOS_TEST_EQUAL(modeRuns.size(), decodedLabels.size());
+
+    size_t decodedIndex = 0;
+    for(size_t run = 0; run < modeRuns.size(); ++run)
+    {
+        const auto frameIndex = static_cast<size_t>(inputLabels[run].index);
+        const auto& inputRun = inputRuns[run + ((run >= junkRunIndex) ? 1 : 0)];
+
+        FECTests::testLabelsEqual(
+            Pothos::Label(modeLabelID, modeRuns[run].mode, decodedIndex),
+            decodedLabels[run]);
+        POTHOS_TEST_EQUALA(
+            input.as<const std::uint8_t*>() + frameIndex,
+            decodedValues.as<const std::uint8_t*>() + decodedIndex,
+            inputRun.elements());
+
+        decodedIndex += inputRun.elements();
+    }
+}
+
+//
+// Test that the streaming decoder decodes an unframed stream with a fixed
+// lag, with and without puncturing
+//
+
+static void testStreamingConvDecoder(const std::vector<int>& puncturePattern)
+{
+    // Encode the stream as one long flushed block, and make sure punctured
+    // streams end on a whole puncture period.
+    constexpr size_t numDataBits = 3000;
+
+    auto decoder = Pothos::BlockRegistry::make("/fec/streaming_conv_decoder");
+    decoder.call("setPuncturePattern", puncturePattern);
+
+    const auto gen = decoder.call<std::vector<unsigned>>("gen");
+    const auto tracebackDepth = decoder.call<size_t>("tracebackDepth");
+
+    lte_conv_code convCode;
+    std::memset(&convCode, 0, sizeof(convCode));
+    convCode.n = decoder.call<int>("N");
+    convCode.k = decoder.call<int>("K");
+    convCode.len = static_cast<int>(numDataBits);
+    std::copy(gen.begin(), gen.end(), convCode.gen);
+    convCode.term = CONV_TERM_FLUSH;
+
+    const size_t numSteps = numDataBits + convCode.k - 1;
+    const size_t unpuncturedLength = numSteps * convCode.n;
+    if(!puncturePattern.empty()) POTHOS_TEST_EQUAL(0, (unpuncturedLength % puncturePattern.size()));
+
+    const auto input = FECTests::getRandomInput(numDataBits, true /*asBits*/);
+    std::vector<std::uint8_t> encoded(unpuncturedLength);
+    POTHOS_TEST_EQUAL(
+        static_cast<int>(unpuncturedLength),
+        lte_conv_encode(&convCode, input.as<const std::uint8_t*>(), encoded.data()));
+
+    std::vector<std::int8_t> softValues;
+    for(size_t i = 0; i < unpuncturedLength; ++i)
+    {
+        if(puncturePattern.empty() || puncturePattern[i % puncturePattern.size()])
+        {
+            softValues.emplace_back(encoded[i] ? 64 : -64);
+        }
+    }
+
+    Pothos::BufferChunk softInput("int8", softValues.size());
+    std::memcpy(softInput.as<void*>(), softValues.data(), softValues.size());
+
+    // Every bit but the last traceback depth's worth is output.
+    const auto output = getCoderOutput(decoder, softInput);
+    POTHOS_TEST_EQUAL(numSteps - tracebackDepth, output.elements());
+    POTHOS_TEST_EQUALA(
+        input.as<const std::uint8_t*>(),
+        output.as<const std::uint8_t*>(),
+        std::min(numDataBits, output.elements()));
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_streaming_conv_decoder)
+{
+    testStreamingConvDecoder({});
+
+    // Rate 3/4
+    testStreamingConvDecoder({1,1,1,0,0,1});
+}
@@ -2,6 +2,10 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "CoderTests.hpp"
+#include "LTERateMatching.hpp"
+#include "LTETurboUtility.hpp"
+#include "LTETurboWorkspacePool.hpp"
+#include "TestUtility.hpp"
 
 #include <Pothos/Framework.hpp>
 #include <Pothos/Proxy.hpp>
@@ -9,6 +13,15 @@
 
 #include <turbofec/turbo.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
 POTHOS_TEST_BLOCK("/fec/tests", test_lte_encoder_output_length)
 {
     constexpr size_t numInputElems = TURBO_MAX_K;
@@ -50,3 +63,1305 @@ POTHOS_TEST_BLOCK("/fec/tests", test_lte_coder_symmetry)
         lteDecoder,
         numElems);
 }
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_decoder_early_termination)
+{
+    constexpr size_t numElems = TURBO_MAX_K;
+    constexpr unsigned rgen = 013;
+    constexpr unsigned gen = 015;
+    constexpr size_t numIterations = 8;
+
+    for(const std::string earlyTermination: {"CRC24A", "CRC24B", "Convergence"})
+    {
+        std::cout << "Early termination: " << earlyTermination << std::endl;
+
+        auto lteEncoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+        auto lteDecoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+        lteDecoder.call("setEarlyTermination", earlyTermination);
+        POTHOS_TEST_EQUAL(earlyTermination, lteDecoder.call<std::string>("earlyTermination"));
+
+        FECTests::testCoderSymmetry(
+            lteEncoder,
+            lteDecoder,
+            numElems);
+
+        // Random input won't have a valid CRC, so only convergence stops
+        // early here.
+        const auto averageIterations = lteDecoder.call<double>("averageIterations");
+        if("Convergence" == earlyTermination) POTHOS_TEST_TRUE(averageIterations < numIterations);
+        else                                  POTHOS_TEST_EQUAL(double(numIterations), averageIterations);
+    }
+
+    // Code blocks that end in the right CRC should stop as soon as they
+    // decode.
+    constexpr size_t blockSize = 1024;
+    constexpr size_t numBlocks = 4;
+    for(const std::string earlyTermination: {"CRC24A", "CRC24B"})
+    {
+        std::cout << "Early termination: " << earlyTermination << " (with CRC)" << std::endl;
+
+        const std::string blockStartID = "START";
+
+        auto input = FECTests::getRandomInput(numBlocks * blockSize, true /*asBits*/);
+        for(size_t block = 0; block < numBlocks; ++block)
+        {
+            auto* bits = input.as<std::uint8_t*>() + (block * blockSize);
+            const size_t numDataBits = blockSize - LTECRCLength;
+            const auto crc = ("CRC24A" == earlyTermination) ? calcLTECRC24A(bits, numDataBits)
+                                                            : calcLTECRC24B(bits, numDataBits);
+            writeLTECRC(crc, bits + numDataBits);
+        }
+
+        auto lteEncoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+        lteEncoder.call("setBlockStartID", blockStartID);
+
+        auto lteDecoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+        lteDecoder.call("setBlockStartID", blockStartID);
+        lteDecoder.call("setEarlyTermination", earlyTermination);
+
+        auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+        feederSource.call("feedBuffer", input);
+        for(size_t block = 0; block < numBlocks; ++block)
+        {
+            feederSource.call("feedLabel", Pothos::Label(blockStartID, blockSize, block * blockSize));
+        }
+
+        auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+
+        {
+            Pothos::Topology topology;
+
+            topology.connect(feederSource, 0, lteEncoder, 0);
+            for(size_t port = 0; port < 3; ++port)
+            {
+                topology.connect(lteEncoder, port, lteDecoder, port);
+            }
+            topology.connect(lteDecoder, 0, collectorSink, 0);
+
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+        }
+
+        const auto output = collectorSink.call<Pothos::BufferChunk>("getBuffer");
+        POTHOS_TEST_EQUAL(input.elements(), output.elements());
+        POTHOS_TEST_EQUALA(
+            input.as<const std::uint8_t*>(),
+            output.as<const std::uint8_t*>(),
+            input.elements());
+        POTHOS_TEST_TRUE(lteDecoder.call<double>("averageIterations") < numIterations);
+    }
+
+    auto lteDecoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+    POTHOS_TEST_THROWS(
+        lteDecoder.call("setEarlyTermination", "CRC16"),
+        Pothos::ProxyExceptionMessage);
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_decoder_parallel_windows)
+{
+    constexpr size_t numElems = TURBO_MAX_K;
+    constexpr unsigned rgen = 013;
+    constexpr unsigned gen = 015;
+    constexpr size_t numIterations = 4;
+
+    for(const size_t numWindows: {2, 8, 96})
+    {
+        std::cout << "Windows: " << numWindows << std::endl;
+
+        auto lteEncoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+        auto lteDecoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+        lteDecoder.call("setNumWindows", numWindows);
+        POTHOS_TEST_EQUAL(numWindows, lteDecoder.call<size_t>("numWindows"));
+
+        FECTests::testCoderSymmetry(
+            lteEncoder,
+            lteDecoder,
+            numElems);
+        POTHOS_TEST_EQUAL(double(numIterations), lteDecoder.call<double>("averageIterations"));
+    }
+
+    auto lteDecoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+    POTHOS_TEST_THROWS(
+        lteDecoder.call("setNumWindows", 0),
+        Pothos::ProxyExceptionMessage);
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_turbo_workspace_pool)
+{
+    LTETurboWorkspacePool pool;
+    POTHOS_TEST_EQUAL(0U, pool.numWorkspaces());
+
+    // Workspaces are only allocated when none are free.
+    const LTETurboWorkspace* workspace0 = nullptr;
+    const LTETurboWorkspace* workspace1 = nullptr;
+    {
+        auto lease0 = pool.checkOut();
+        POTHOS_TEST_EQUAL(1U, pool.numWorkspaces());
+
+        auto lease1 = pool.checkOut();
+        POTHOS_TEST_EQUAL(2U, pool.numWorkspaces());
+        POTHOS_TEST_TRUE(&*lease0 != &*lease1);
+
+        workspace0 = &*lease0;
+        workspace1 = &*lease1;
+    }
+
+    // The leases were checked in in reverse order, so the most recently
+    // checked in is workspace 0.
+    {
+        auto lease = pool.checkOut();
+        POTHOS_TEST_TRUE(workspace0 == &*lease);
+    }
+    {
+        auto lease0 = pool.checkOut();
+        auto lease1 = pool.checkOut();
+        POTHOS_TEST_TRUE(workspace0 == &*lease0);
+        POTHOS_TEST_TRUE(workspace1 == &*lease1);
+        POTHOS_TEST_EQUAL(2U, pool.numWorkspaces());
+
+        // The pool only grows past its peak concurrency.
+        auto lease2 = pool.checkOut();
+        POTHOS_TEST_EQUAL(3U, pool.numWorkspaces());
+    }
+    POTHOS_TEST_EQUAL(3U, pool.numWorkspaces());
+}
+
+// Unlike FECTests::getRandomInput, this gives the same bits on every run,
+// for tests whose noisy results are only checked against thresholds.
+static Pothos::BufferChunk getSeededRandomBits(size_t numBits, std::uint32_t seed)
+{
+    std::mt19937 generator(seed);
+
+    Pothos::BufferChunk bits("uint8", numBits);
+    for(size_t bit = 0; bit < numBits; ++bit)
+    {
+        bits.as<std::uint8_t*>()[bit] = generator() & 1;
+    }
+
+    return bits;
+}
+
+// Encodes random code blocks of the given size, and adds noise to the
+// encoded streams with a fixed seed.
+static std::vector<Pothos::BufferChunk> getNoisyLTECodeBlocks(
+    const Pothos::BufferChunk& input,
+    size_t blockSize,
+    float snr)
+{
+    const std::string blockStartID = "START";
+    constexpr unsigned rgen = 013;
+    constexpr unsigned gen = 015;
+
+    auto encoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+    encoder.call("setBlockStartID", blockStartID);
+
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+    feederSource.call("feedBuffer", input);
+    for(size_t index = 0; index < input.elements(); index += blockSize)
+    {
+        feederSource.call("feedLabel", Pothos::Label(blockStartID, blockSize, index));
+    }
+
+    std::vector<Pothos::Proxy> collectorSinks;
+    for(size_t port = 0; port < 3; ++port)
+    {
+        collectorSinks.emplace_back(Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8"));
+    }
+
+    {
+        Pothos::Topology topology;
+
+        topology.connect(feederSource, 0, encoder, 0);
+        for(size_t port = 0; port < 3; ++port)
+        {
+            topology.connect(encoder, port, collectorSinks[port], 0);
+        }
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+    }
+
+    std::srand(1);
+
+    std::vector<Pothos::BufferChunk> softBits;
+    for(size_t port = 0; port < 3; ++port)
+    {
+        const auto encoded = collectorSinks[port].call<Pothos::BufferChunk>("getBuffer");
+        POTHOS_TEST_EQUAL((input.elements() / blockSize) * (blockSize + 4), encoded.elements());
+
+        int numBitsChanged = 0;
+        softBits.emplace_back(FECTests::addNoiseAndGetError(encoded, snr, FECTests::defaultAmp, &numBitsChanged));
+    }
+
+    return softBits;
+}
+
+// Decodes the code blocks from getNoisyLTECodeBlocks with an LTE Turbo
+// Soft Decoder, giving its decoded bits and int16 LLRs.
+static void decodeNoisyLTECodeBlocks(
+    const Pothos::Proxy& decoder,
+    const std::vector<Pothos::BufferChunk>& softBits,
+    size_t blockSize,
+    Pothos::BufferChunk* bitsOut,
+    Pothos::BufferChunk* llrsOut)
+{
+    const std::string blockStartID = "START";
+    decoder.call("setBlockStartID", blockStartID);
+
+    std::vector<Pothos::Proxy> feederSources;
+    for(size_t port = 0; port < 3; ++port)
+    {
+        feederSources.emplace_back(Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8"));
+        feederSources.back().call("feedBuffer", softBits[port]);
+    }
+    for(size_t index = 0; index < softBits[0].elements(); index += (blockSize + 4))
+    {
+        feederSources[0].call("feedLabel", Pothos::Label(blockStartID, blockSize + 4, index));
+    }
+
+    auto bitCollectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+    auto llrCollectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "int16");
+
+    {
+        Pothos::Topology topology;
+
+        for(size_t port = 0; port < 3; ++port)
+        {
+            topology.connect(feederSources[port], 0, decoder, port);
+        }
+        topology.connect(decoder, 0, bitCollectorSink, 0);
+        topology.connect(decoder, 1, llrCollectorSink, 0);
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+    }
+
+    *bitsOut = bitCollectorSink.call<Pothos::BufferChunk>("getBuffer");
+    *llrsOut = llrCollectorSink.call<Pothos::BufferChunk>("getBuffer");
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_decoder_radix4)
+{
+    constexpr size_t numElems = TURBO_MAX_K;
+    constexpr unsigned rgen = 013;
+    constexpr unsigned gen = 015;
+    constexpr size_t numIterations = 4;
+
+    for(const size_t numWindows: {1, 8})
+    {
+        std::cout << "Windows: " << numWindows << std::endl;
+
+        auto lteEncoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+        auto lteDecoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+        lteDecoder.call("setRadix", 4);
+        lteDecoder.call("setNumWindows", numWindows);
+        POTHOS_TEST_EQUAL(4U, lteDecoder.call<size_t>("radix"));
+
+        FECTests::testCoderSymmetry(
+            lteEncoder,
+            lteDecoder,
+            numElems);
+    }
+
+    // With noise, every algorithm should still give the same bits, LLRs,
+    // and iterations with either radix.
+    constexpr size_t blockSize = 1024;
+    constexpr size_t numBlocks = 16;
+    constexpr size_t numNoisyIterations = 8;
+    constexpr float snr = -1.0f;
+
+    const auto input = FECTests::getRandomInput(numBlocks * blockSize, true /*asBits*/);
+    const auto softBits = getNoisyLTECodeBlocks(input, blockSize, snr);
+
+    for(const std::string algorithm: {"MaxLogMAP", "ScaledMaxLogMAP", "LogMAP"})
+    {
+        for(const size_t numWindows: {1, 8})
+        {
+            std::cout << "Algorithm: " << algorithm << ", windows: " << numWindows << " (noisy)" << std::endl;
+
+            Pothos::BufferChunk bits[2];
+            Pothos::BufferChunk llrs[2];
+            double averageIterations[2];
+
+            for(const size_t radix: {2, 4})
+            {
+                const size_t i = (radix / 2) - 1;
+
+                auto lteDecoder = Pothos::BlockRegistry::make("/fec/lte_turbo_soft_decoder", numNoisyIterations, true, "int16");
+                lteDecoder.call("setAlgorithm", algorithm);
+                lteDecoder.call("setEarlyTermination", "Convergence");
+                lteDecoder.call("setNumWindows", numWindows);
+                lteDecoder.call("setRadix", radix);
+
+                decodeNoisyLTECodeBlocks(lteDecoder, softBits, blockSize, &bits[i], &llrs[i]);
+                averageIterations[i] = lteDecoder.call<double>("averageIterations");
+            }
+
+            POTHOS_TEST_EQUAL(input.elements(), bits[0].elements());
+            POTHOS_TEST_EQUAL(bits[0].elements(), bits[1].elements());
+            POTHOS_TEST_EQUALA(
+                bits[0].as<const std::uint8_t*>(),
+                bits[1].as<const std::uint8_t*>(),
+                bits[0].elements());
+
+            POTHOS_TEST_EQUAL(input.elements(), llrs[0].elements());
+            POTHOS_TEST_EQUAL(llrs[0].elements(), llrs[1].elements());
+            POTHOS_TEST_EQUALA(
+                llrs[0].as<const std::int16_t*>(),
+                llrs[1].as<const std::int16_t*>(),
+                llrs[0].elements());
+
+            POTHOS_TEST_EQUAL(averageIterations[0], averageIterations[1]);
+        }
+    }
+
+    auto lteDecoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+    POTHOS_TEST_THROWS(
+        lteDecoder.call("setRadix", 8),
+        Pothos::ProxyExceptionMessage);
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_decoder_algorithms)
+{
+    constexpr size_t numElems = TURBO_MAX_K;
+    constexpr unsigned rgen = 013;
+    constexpr unsigned gen = 015;
+    constexpr size_t numIterations = 4;
+
+    for(const std::string algorithm: {"MaxLogMAP", "ScaledMaxLogMAP", "LogMAP"})
+    {
+        std::cout << "Algorithm: " << algorithm << std::endl;
+
+        auto lteEncoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+        auto lteDecoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+        lteDecoder.call("setAlgorithm", algorithm);
+        lteDecoder.call("setExtrinsicScale", 0.5);
+        POTHOS_TEST_EQUAL(algorithm, lteDecoder.call<std::string>("algorithm"));
+        POTHOS_TEST_EQUAL(0.5, lteDecoder.call<double>("extrinsicScale"));
+
+        FECTests::testCoderSymmetry(
+            lteEncoder,
+            lteDecoder,
+            numElems);
+    }
+
+    // With noise, the more accurate algorithms should give different LLRs
+    // than max-log-MAP, and converge in no more iterations on average.
+    constexpr size_t blockSize = 1024;
+    constexpr size_t numBlocks = 16;
+    constexpr size_t numNoisyIterations = 8;
+    constexpr float snr = -1.0f;
+
+    const auto input = getSeededRandomBits(numBlocks * blockSize, 1);
+    const auto softBits = getNoisyLTECodeBlocks(input, blockSize, snr);
+
+    Pothos::BufferChunk maxLogMAPLLRs;
+    double maxLogMAPIterations = 0.0;
+    for(const std::string algorithm: {"MaxLogMAP", "ScaledMaxLogMAP", "LogMAP"})
+    {
+        std::cout << "Algorithm: " << algorithm << " (noisy)" << std::endl;
+
+        auto lteDecoder = Pothos::BlockRegistry::make("/fec/lte_turbo_soft_decoder", numNoisyIterations, true, "int16");
+        lteDecoder.call("setAlgorithm", algorithm);
+        lteDecoder.call("setEarlyTermination", "Convergence");
+
+        Pothos::BufferChunk bits, llrs;
+        decodeNoisyLTECodeBlocks(lteDecoder, softBits, blockSize, &bits, &llrs);
+        POTHOS_TEST_EQUAL(input.elements(), bits.elements());
+        POTHOS_TEST_EQUAL(input.elements(), llrs.elements());
+
+        const auto averageIterations = lteDecoder.call<double>("averageIterations");
+        std::cout << " * Average iterations: " << averageIterations << std::endl;
+
+        if("MaxLogMAP" == algorithm)
+        {
+            maxLogMAPLLRs = llrs;
+            maxLogMAPIterations = averageIterations;
+        }
+        else
+        {
+            POTHOS_TEST_TRUE(!std::equal(
+                llrs.as<const std::int16_t*>(),
+                llrs.as<const std::int16_t*>() + llrs.elements(),
+                maxLogMAPLLRs.as<const std::int16_t*>()));
+            POTHOS_TEST_TRUE(averageIterations <= maxLogMAPIterations);
+        }
+    }
+
+    auto lteDecoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+    POTHOS_TEST_THROWS(
+        lteDecoder.call("setAlgorithm", "SOVA"),
+        Pothos::ProxyExceptionMessage);
+    lteDecoder.call("setExtrinsicScale", 0.5);
+    POTHOS_TEST_THROWS(
+        lteDecoder.call("setExtrinsicScale", -0.5),
+        Pothos::ProxyExceptionMessage);
+    POTHOS_TEST_THROWS(
+        lteDecoder.call("setExtrinsicScale", 0.0),
+        Pothos::ProxyExceptionMessage);
+    POTHOS_TEST_THROWS(
+        lteDecoder.call("setExtrinsicScale", 1.5),
+        Pothos::ProxyExceptionMessage);
+    POTHOS_TEST_EQUAL(0.5, lteDecoder.call<double>("extrinsicScale"));
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_turbo_interleaver)
+{
+    size_t numBlockSizes = 0;
+
+    for(size_t blockSize = TURBO_MIN_K; blockSize <= TURBO_MAX_K; ++blockSize)
+    {
+        if(!isLTETurboBlockSize(blockSize)) continue;
+        ++numBlockSizes;
+
+        // The interleaver must be a permutation.
+        const auto interleaver = getLTETurboInterleaver(blockSize);
+        POTHOS_TEST_EQUAL(blockSize, interleaver.size());
+
+        std::vector<bool> isUsed(blockSize, false);
+        for(const auto index: interleaver)
+        {
+            POTHOS_TEST_TRUE(index < blockSize);
+            POTHOS_TEST_TRUE(!isUsed[index]);
+            isUsed[index] = true;
+        }
+    }
+
+    // TS 36.212 Table 5.1.3-3
+    POTHOS_TEST_EQUAL(188U, numBlockSizes);
+}
+
+//
+// Test that transport blocks are segmented and CRC'd as in TS 36.212
+//
+
+// The LTE CRCs leave no remainder over the bits they protect followed by
+// the CRC itself.
+static std::uint32_t getCRC24Remainder(std::uint32_t poly, const std::uint8_t* bits, size_t numBits)
+{
+    std::uint32_t crc = 0;
+    for(size_t bit = 0; bit < numBits; ++bit)
+    {
+        const bool feedback = ((crc >> 23) ^ bits[bit]) & 1;
+        crc = (crc << 1) & 0xFFFFFF;
+        if(feedback) crc ^= poly;
+    }
+
+    return crc;
+}
+
+struct TransportBlockTestParams
+{
+    size_t transportBlockSize;
+    size_t numCodeBlocks;
+    size_t numFillerBits;
+    size_t numSmallBlocks;
+    size_t smallBlockSize;
+    size_t largeBlockSize;
+};
+
+static void testTransportBlock(const TransportBlockTestParams& params)
+{
+    const std::string blockStartID = "START";
+    constexpr unsigned rgen = 013;
+    constexpr unsigned gen = 015;
+
+    std::cout << " * Testing " << params.transportBlockSize << " bits..." << std::endl;
+
+    auto encoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+    encoder.call("setBlockStartID", blockStartID);
+    encoder.call("setTransportBlock", true);
+    POTHOS_TEST_TRUE(encoder.call<bool>("transportBlock"));
+
+    const auto input = FECTests::getRandomInput(params.transportBlockSize, true /*asBits*/);
+
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+    feederSource.call("feedBuffer", input);
+    feederSource.call("feedLabel", Pothos::Label(blockStartID, params.transportBlockSize, 0));
+
+    std::vector<Pothos::Proxy> collectorSinks;
+    {
+        Pothos::Topology topology;
+
+        topology.connect(feederSource, 0, encoder, 0);
+        for(size_t port = 0; port < 3; ++port)
+        {
+            collectorSinks.emplace_back(Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8"));
+            topology.connect(encoder, port, collectorSinks.back(), 0);
+        }
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+    }
+
+    const auto labels = collectorSinks[0].call<std::vector<Pothos::Label>>("getLabels");
+    POTHOS_TEST_EQUAL(1U, labels.size());
+    FECTests::testLabelsEqual(
+        Pothos::Label(blockStartID, params.transportBlockSize, 0),
+        labels[0]);
+
+    const size_t numLargeBlocks = params.numCodeBlocks - params.numSmallBlocks;
+    const size_t streamLength = (params.numSmallBlocks * (params.smallBlockSize + 4)) +
+                                (numLargeBlocks * (params.largeBlockSize + 4));
+    for(const auto& collectorSink: collectorSinks)
+    {
+        POTHOS_TEST_EQUAL(streamLength, collectorSink.call<Pothos::BufferChunk>("getBuffer").elements());
+    }
+
+    // The systematic stream starts with each code block, so put the
+    // transport block back together from them.
+    const auto systematic = collectorSinks[0].call<Pothos::BufferChunk>("getBuffer");
+    const auto* systematicBits = systematic.as<const std::uint8_t*>();
+    const size_t codeBlockCRCLength = (params.numCodeBlocks > 1) ? 24 : 0;
+
+    std::vector<std::uint8_t> transportBlockWithCRC;
+    size_t streamIndex = 0;
+    for(size_t codeBlock = 0; codeBlock < params.numCodeBlocks; ++codeBlock)
+    {
+        const size_t blockSize = (codeBlock < params.numSmallBlocks) ? params.smallBlockSize : params.largeBlockSize;
+        const size_t numFillerBits = (0 == codeBlock) ? params.numFillerBits : 0;
+        const auto* codeBlockBits = systematicBits + streamIndex;
+
+        POTHOS_TEST_EQUAL(
+            std::count(codeBlockBits, codeBlockBits + numFillerBits, 0),
+            static_cast<std::ptrdiff_t>(numFillerBits));
+        if(codeBlockCRCLength > 0)
+        {
+            POTHOS_TEST_EQUAL(0U, getCRC24Remainder(0x800063, codeBlockBits, blockSize));
+        }
+
+        transportBlockWithCRC.insert(
+            transportBlockWithCRC.end(),
+            codeBlockBits + numFillerBits,
+            codeBlockBits + blockSize - codeBlockCRCLength);
+        streamIndex += blockSize + 4;
+    }
+
+    POTHOS_TEST_EQUAL(params.transportBlockSize + 24, transportBlockWithCRC.size());
+    POTHOS_TEST_EQUALA(
+        input.as<const std::uint8_t*>(),
+        transportBlockWithCRC.data(),
+        params.transportBlockSize);
+    POTHOS_TEST_EQUAL(0U, getCRC24Remainder(0x864CFB, transportBlockWithCRC.data(), transportBlockWithCRC.size()));
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_encoder_transport_block)
+{
+    static const std::vector<TransportBlockTestParams> allParams =
+    {
+        // Padded to the smallest code block
+        {16, 1, 0, 0, 0, 40},
+        {101, 1, 3, 0, 0, 128},
+
+        // The largest unsegmented transport block
+        {6120, 1, 0, 0, 0, 6144},
+
+        // Segmented into code blocks of different sizes
+        {6121, 2, 15, 1, 3072, 3136},
+        {12000, 2, 24, 1, 6016, 6080},
+
+        // The largest 20 MHz single-layer transport block
+        {75376, 13, 0, 0, 5760, 5824},
+    };
+
+    for(const auto& params: allParams) testTransportBlock(params);
+
+    POTHOS_TEST_EQUAL(64U, calcLTECodeBlockSegmentation(LTEMaxTransportBlockSize).numCodeBlocks);
+    POTHOS_TEST_THROWS(
+        calcLTECodeBlockSegmentation(0),
+        Pothos::InvalidArgumentException);
+    POTHOS_TEST_THROWS(
+        calcLTECodeBlockSegmentation(LTEMaxTransportBlockSize + 1),
+        Pothos::InvalidArgumentException);
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_coder_transport_block_symmetry)
+{
+    const std::string blockStartID = "START";
+    constexpr unsigned rgen = 013;
+    constexpr unsigned gen = 015;
+    constexpr size_t numIterations = 4;
+
+    // Queue several transport blocks at once, so the decoder gathers
+    // them into one batch.
+    const std::vector<size_t> transportBlockSizes = {101, 12000, 75376, 16};
+
+    size_t totalSize = 0;
+    for(const auto transportBlockSize: transportBlockSizes) totalSize += transportBlockSize;
+    const auto input = FECTests::getRandomInput(totalSize, true /*asBits*/);
+
+    for(const std::string earlyTermination: {"None", "CRC24A"})
+    {
+        std::cout << " * Early termination: " << earlyTermination << std::endl;
+
+        auto encoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+        encoder.call("setBlockStartID", blockStartID);
+        encoder.call("setTransportBlock", true);
+
+        auto decoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+        decoder.call("setBlockStartID", blockStartID);
+        decoder.call("setTransportBlock", true);
+        decoder.call("setEarlyTermination", earlyTermination);
+        POTHOS_TEST_TRUE(decoder.call<bool>("transportBlock"));
+
+        auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+        feederSource.call("feedBuffer", input);
+
+        size_t labelIndex = 0;
+        for(const auto transportBlockSize: transportBlockSizes)
+        {
+            feederSource.call("feedLabel", Pothos::Label(blockStartID, transportBlockSize, labelIndex));
+            labelIndex += transportBlockSize;
+        }
+
+        auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+
+        {
+            Pothos::Topology topology;
+
+            topology.connect(feederSource, 0, encoder, 0);
+            for(size_t port = 0; port < 3; ++port)
+            {
+                topology.connect(encoder, port, decoder, port);
+            }
+            topology.connect(decoder, 0, collectorSink, 0);
+
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+        }
+
+        // With no noise, every transport block should come back in order,
+        // each still labeled with its size.
+        const auto output = collectorSink.call<Pothos::BufferChunk>("getBuffer");
+        POTHOS_TEST_EQUAL(totalSize, output.elements());
+        POTHOS_TEST_EQUALA(
+            input.as<const std::uint8_t*>(),
+            output.as<const std::uint8_t*>(),
+            totalSize);
+
+        const auto labels = collectorSink.call<std::vector<Pothos::Label>>("getLabels");
+        POTHOS_TEST_EQUAL(transportBlockSizes.size(), labels.size());
+
+        labelIndex = 0;
+        for(size_t block = 0; block < transportBlockSizes.size(); ++block)
+        {
+            FECTests::testLabelsEqual(
+                Pothos::Label(blockStartID, transportBlockSizes[block], labelIndex),
+                labels[block]);
+            labelIndex += transportBlockSizes[block];
+        }
+
+        // Every code block has a CRC to check, so with no noise, each
+        // should stop early.
+        const auto averageIterations = decoder.call<double>("averageIterations");
+        if("None" == earlyTermination) POTHOS_TEST_EQUAL(double(numIterations), averageIterations);
+        else                           POTHOS_TEST_TRUE(averageIterations < numIterations);
+    }
+
+    // Without a block start ID, there's no transport block size, so neither
+    // block should activate.
+    auto encoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+    encoder.call("setTransportBlock", true);
+
+    auto decoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+    decoder.call("setTransportBlock", true);
+
+    auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+    auto collectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+
+    {
+        Pothos::Topology topology;
+        topology.connect(feederSource, 0, encoder, 0);
+        topology.connect(encoder, 0, collectorSink, 0);
+        POTHOS_TEST_THROWS(
+            topology.commit(),
+            Pothos::Exception);
+    }
+    {
+        Pothos::Topology topology;
+        for(size_t port = 0; port < 3; ++port)
+        {
+            topology.connect(feederSource, 0, decoder, port);
+        }
+        topology.connect(decoder, 0, collectorSink, 0);
+        POTHOS_TEST_THROWS(
+            topology.commit(),
+            Pothos::Exception);
+    }
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_decoder_llrs)
+{
+    const std::string blockStartID = "START";
+    constexpr unsigned rgen = 013;
+    constexpr unsigned gen = 015;
+    constexpr size_t numIterations = 4;
+
+    const std::vector<size_t> transportBlockSizes = {101, 12000};
+
+    size_t totalSize = 0;
+    for(const auto transportBlockSize: transportBlockSizes) totalSize += transportBlockSize;
+    const auto input = FECTests::getRandomInput(totalSize, true /*asBits*/);
+
+    for(const std::string llrDType: {"int8", "int16"})
+    {
+        std::cout << " * LLR type: " << llrDType << std::endl;
+
+        auto encoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+        encoder.call("setBlockStartID", blockStartID);
+        encoder.call("setTransportBlock", true);
+
+        auto decoder = Pothos::BlockRegistry::make("/fec/lte_turbo_soft_decoder", numIterations, false, llrDType);
+        decoder.call("setBlockStartID", blockStartID);
+        decoder.call("setTransportBlock", true);
+
+        auto feederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+        feederSource.call("feedBuffer", input);
+
+        size_t labelIndex = 0;
+        for(const auto transportBlockSize: transportBlockSizes)
+        {
+            feederSource.call("feedLabel", Pothos::Label(blockStartID, transportBlockSize, labelIndex));
+            labelIndex += transportBlockSize;
+        }
+
+        auto bitCollectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+        auto llrCollectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", llrDType);
+
+        {
+            Pothos::Topology topology;
+
+            topology.connect(feederSource, 0, encoder, 0);
+            for(size_t port = 0; port < 3; ++port)
+            {
+                topology.connect(encoder, port, decoder, port);
+            }
+            topology.connect(decoder, 0, bitCollectorSink, 0);
+            topology.connect(decoder, 1, llrCollectorSink, 0);
+
+            topology.commit();
+            POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+        }
+
+        // Each transport block's bits are packed MSB-first, starting a new
+        // byte, with the last byte padded with zeros.
+        std::vector<std::uint8_t> expectedBytes;
+        size_t bitIndex = 0;
+        for(const auto transportBlockSize: transportBlockSizes)
+        {
+            for(size_t bit = 0; bit < transportBlockSize; ++bit, ++bitIndex)
+            {
+                if(0 == (bit % 8)) expectedBytes.emplace_back(0);
+                expectedBytes.back() |= input.as<const std::uint8_t*>()[bitIndex] << (7 - (bit % 8));
+            }
+        }
+
+        const auto bytes = bitCollectorSink.call<Pothos::BufferChunk>("getBuffer");
+        POTHOS_TEST_EQUAL(expectedBytes.size(), bytes.elements());
+        POTHOS_TEST_EQUALA(
+            expectedBytes.data(),
+            bytes.as<const std::uint8_t*>(),
+            expectedBytes.size());
+
+        // There's still one LLR per bit, whose sign is the bit's hard
+        // decision.
+
+        const auto llrs = llrCollectorSink.call<Pothos::BufferChunk>("getBuffer");
+        POTHOS_TEST_EQUAL(totalSize, llrs.elements());
+
+        const auto* inputBits = input.as<const std::uint8_t*>();
+        for(size_t i = 0; i < totalSize; ++i)
+        {
+            const int llr = ("int8" == llrDType) ? llrs.as<const std::int8_t*>()[i] : llrs.as<const std::int16_t*>()[i];
+            POTHOS_TEST_EQUAL(int(inputBits[i]), (llr > 0) ? 1 : 0);
+        }
+
+        const auto labels = llrCollectorSink.call<std::vector<Pothos::Label>>("getLabels");
+        POTHOS_TEST_EQUAL(transportBlockSizes.size(), labels.size());
+
+        labelIndex = 0;
+        for(size_t block = 0; block < transportBlockSizes.size(); ++block)
+        {
+            FECTests::testLabelsEqual(
+                Pothos::Label(blockStartID, transportBlockSizes[block], labelIndex),
+                labels[block]);
+            labelIndex += transportBlockSizes[block];
+        }
+    }
+
+    POTHOS_TEST_THROWS(
+        Pothos::BlockRegistry::make("/fec/lte_turbo_soft_decoder", numIterations, true, "float32"),
+        Pothos::Exception);
+    POTHOS_TEST_THROWS(
+        Pothos::BlockRegistry::make("/fec/lte_turbo_soft_decoder", numIterations, true, ""),
+        Pothos::Exception);
+}
+
+static Pothos::Label getHARQLabel(const std::string& harqID, size_t process, size_t rv, bool newData, size_t length, size_t index)
+{
+    Pothos::ObjectKwargs data;
+    data["process"] = Pothos::Object(process);
+    data["rv"] = Pothos::Object(rv);
+    data["newData"] = Pothos::Object(newData);
+    data["length"] = Pothos::Object(length);
+
+    return Pothos::Label(harqID, data, index);
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_harq_combiner)
+{
+    const std::string harqID = "HARQ";
+    constexpr size_t length = 1000;
+    constexpr size_t prefixLength = 10;
+
+    // A process's retransmissions combine with its own earlier
+    // transmissions, but not another process's, until it gets new data.
+    // Process 15 is the largest a label can give.
+    struct Transmission
+    {
+        size_t process;
+        size_t rv;
+        bool newData;
+    };
+    const std::vector<Transmission> transmissions =
+    {
+        {1, 0, true},
+        {1, 2, false},
+        {2, 0, true},
+        {1, 3, false},
+        {15, 0, true},
+        {1, 0, true},
+        {15, 1, false},
+    };
+    const size_t totalSize = prefixLength + (transmissions.size() * length);
+
+    auto combiner = Pothos::BlockRegistry::make("/fec/lte_harq_combiner");
+    POTHOS_TEST_EQUAL(harqID, combiner.call<std::string>("harqID"));
+
+    std::vector<Pothos::BufferChunk> inputs;
+    std::vector<Pothos::Proxy> feederSources;
+    std::vector<Pothos::Proxy> collectorSinks;
+    for(size_t port = 0; port < 3; ++port)
+    {
+        // Random bytes are random soft bits, many of which saturate when
+        // combined.
+        inputs.emplace_back(FECTests::getRandomInput(totalSize, false /*asBits*/));
+
+        feederSources.emplace_back(Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8"));
+        feederSources.back().call("feedBuffer", inputs.back());
+
+        collectorSinks.emplace_back(Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8"));
+    }
+    for(size_t i = 0; i < transmissions.size(); ++i)
+    {
+        const auto& transmission = transmissions[i];
+        feederSources[0].call(
+            "feedLabel",
+            getHARQLabel(harqID, transmission.process, transmission.rv, transmission.newData, length, prefixLength + (i * length)));
+    }
+
+    {
+        Pothos::Topology topology;
+
+        for(size_t port = 0; port < 3; ++port)
+        {
+            topology.connect(feederSources[port], 0, combiner, port);
+            topology.connect(combiner, port, collectorSinks[port], 0);
+        }
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+    }
+
+    POTHOS_TEST_EQUAL(3U, combiner.call<size_t>("numProcesses"));
+
+    for(size_t port = 0; port < 3; ++port)
+    {
+        const auto* input = inputs[port].as<const std::int8_t*>();
+
+        const auto output = collectorSinks[port].call<Pothos::BufferChunk>("getBuffer");
+        POTHOS_TEST_EQUAL(totalSize, output.elements());
+
+        // Anything before the first transmission passes through.
+        std::vector<std::int8_t> expected(input, input + prefixLength);
+
+        std::vector<std::vector<int>> softBuffers(16);
+        for(size_t i = 0; i < transmissions.size(); ++i)
+        {
+            const auto& transmission = transmissions[i];
+            const auto* softBits = input + prefixLength + (i * length);
+
+            auto& softBuffer = softBuffers[transmission.process];
+            if(transmission.newData) softBuffer.assign(length, 0);
+
+            for(size_t bit = 0; bit < length; ++bit)
+            {
+                softBuffer[bit] = std::max(-128, std::min(127, softBuffer[bit] + softBits[bit]));
+                expected.emplace_back(static_cast<std::int8_t>(softBuffer[bit]));
+            }
+        }
+
+        POTHOS_TEST_EQUALA(
+            expected.data(),
+            output.as<const std::int8_t*>(),
+            totalSize);
+    }
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_rate_matching_symmetry)
+{
+    const std::string blockStartID = "START";
+    constexpr unsigned rgen = 013;
+    constexpr unsigned gen = 015;
+    constexpr size_t numIterations = 4;
+
+    for(const size_t transportBlockSize: {101, 12000})
+    {
+        // Punctured to about rate 1/2, and repeated to about rate 1/4
+        for(const size_t rateMultiple: {2, 4})
+        {
+            for(const size_t rv: {0, 2})
+            {
+                const size_t numOutputBits = ((rateMultiple * (transportBlockSize + 24)) + 1) & ~size_t(1);
+
+                std::cout << " * Transport block size: " << transportBlockSize
+                          << ", output bits: " << numOutputBits
+                          << ", rv: " << rv << std::endl;
+
+                const auto input = FECTests::getRandomInput(transportBlockSize, true /*asBits*/);
+
+                auto encoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+                encoder.call("setBlockStartID", blockStartID);
+                encoder.call("setTransportBlock", true);
+
+                auto rateMatcher = Pothos::BlockRegistry::make("/fec/lte_rate_matcher");
+                rateMatcher.call("setNumOutputBits", numOutputBits);
+                rateMatcher.call("setRV", rv);
+                POTHOS_TEST_EQUAL(numOutputBits, rateMatcher.call<size_t>("numOutputBits"));
+                POTHOS_TEST_EQUAL(rv, rateMatcher.call<size_t>("rv"));
+
+                auto bitFeederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+                bitFeederSource.call("feedBuffer", input);
+                bitFeederSource.call("feedLabel", Pothos::Label(blockStartID, transportBlockSize, 0));
+
+                auto rateMatchedCollectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+
+                {
+                    Pothos::Topology topology;
+
+                    topology.connect(bitFeederSource, 0, encoder, 0);
+                    for(size_t port = 0; port < 3; ++port)
+                    {
+                        topology.connect(encoder, port, rateMatcher, port);
+                    }
+                    topology.connect(rateMatcher, 0, rateMatchedCollectorSink, 0);
+
+                    topology.commit();
+                    POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+                }
+
+                const auto rateMatched = rateMatchedCollectorSink.call<Pothos::BufferChunk>("getBuffer");
+                POTHOS_TEST_EQUAL(numOutputBits, rateMatched.elements());
+
+                const auto labels = rateMatchedCollectorSink.call<std::vector<Pothos::Label>>("getLabels");
+                POTHOS_TEST_EQUAL(1U, labels.size());
+                FECTests::testLabelsEqual(
+                    Pothos::Label(blockStartID, transportBlockSize, 0),
+                    labels[0]);
+
+                // Map the rate-matched bits to confident soft bits.
+                Pothos::BufferChunk softBits("int8", numOutputBits);
+                for(size_t i = 0; i < numOutputBits; ++i)
+                {
+                    softBits.as<std::int8_t*>()[i] = rateMatched.as<const std::uint8_t*>()[i] ? 100 : -100;
+                }
+
+                auto rateDematcher = Pothos::BlockRegistry::make("/fec/lte_rate_dematcher");
+                rateDematcher.call("setNumOutputBits", numOutputBits);
+                rateDematcher.call("setRV", rv);
+
+                auto decoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+                decoder.call("setBlockStartID", blockStartID);
+                decoder.call("setTransportBlock", true);
+
+                auto softFeederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", "int8");
+                softFeederSource.call("feedBuffer", softBits);
+                softFeederSource.call("feedLabel", Pothos::Label(blockStartID, transportBlockSize, 0));
+
+                auto decodedCollectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+
+                {
+                    Pothos::Topology topology;
+
+                    topology.connect(softFeederSource, 0, rateDematcher, 0);
+                    for(size_t port = 0; port < 3; ++port)
+                    {
+                        topology.connect(rateDematcher, port, decoder, port);
+                    }
+                    topology.connect(decoder, 0, decodedCollectorSink, 0);
+
+                    topology.commit();
+                    POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+                }
+
+                const auto output = decodedCollectorSink.call<Pothos::BufferChunk>("getBuffer");
+                POTHOS_TEST_EQUAL(transportBlockSize, output.elements());
+                POTHOS_TEST_EQUALA(
+                    input.as<const std::uint8_t*>(),
+                    output.as<const std::uint8_t*>(),
+                    transportBlockSize);
+            }
+        }
+    }
+
+    // Each code block gets a whole number of modulation symbols, with the
+    // last ones taking the remainder.
+    const std::vector<size_t> expectedSizes = {332, 334, 334};
+    POTHOS_TEST_TRUE(expectedSizes == calcLTERateMatchedSizes(3, 1000, 2, 1));
+    POTHOS_TEST_THROWS(
+        calcLTERateMatchedSizes(3, 1001, 2, 1),
+        Pothos::InvalidArgumentException);
+
+    auto rateMatcher = Pothos::BlockRegistry::make("/fec/lte_rate_matcher");
+    POTHOS_TEST_EQUAL(1440U, rateMatcher.call<size_t>("numOutputBits"));
+    POTHOS_TEST_THROWS(
+        rateMatcher.call("setNumOutputBits", 0),
+        Pothos::ProxyExceptionMessage);
+    POTHOS_TEST_THROWS(
+        rateMatcher.call("setRV", 4),
+        Pothos::ProxyExceptionMessage);
+    POTHOS_TEST_THROWS(
+        rateMatcher.call("setModulationOrder", 3),
+        Pothos::ProxyExceptionMessage);
+}
+
+// Rate matches a code block whose streams hold each bit's stream and index,
+// as (stream << 6) | index.
+static std::vector<std::uint8_t> getLTERateMatchedIndices(
+    size_t blockSize,
+    size_t circularBufferSize,
+    size_t rv,
+    size_t outputSize)
+{
+    std::vector<std::vector<std::uint8_t>> streams(3);
+    for(size_t stream = 0; stream < streams.size(); ++stream)
+    {
+        for(size_t index = 0; index < (blockSize + 4); ++index)
+        {
+            streams[stream].emplace_back(static_cast<std::uint8_t>((stream << 6) | index));
+        }
+    }
+    const std::uint8_t* streamPtrs[] = {streams[0].data(), streams[1].data(), streams[2].data()};
+
+    std::vector<std::uint8_t> output(outputSize);
+    LTERateMatchingTable(blockSize, 0, circularBufferSize).rateMatch(rv, streamPtrs, outputSize, output.data());
+
+    return output;
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_rate_matching_known_answer)
+{
+    // K = 40 gives 2 rows of 32 columns per sub-block, the first 20 bits of
+    // which are dummy bits, and a 192-bit circular buffer. Each redundancy
+    // version starts at k0 = 2 * ((24 * rv) + 2), or 4, 52, 100, and 148,
+    // the first two in the first stream's sub-block, and the others in the
+    // interlaced second and third streams' sub-blocks.
+    constexpr size_t blockSize = 40;
+    POTHOS_TEST_EQUAL(192U, calcLTECircularBufferSize(blockSize, 1, 0));
+
+    const std::vector<std::vector<std::uint8_t>> expectedRVStarts =
+    {
+        {0x14, 0x04, 0x24, 0x10, 0x00, 0x20, 0x18, 0x08},
+        {0x17, 0x07, 0x27, 0x13, 0x03, 0x23, 0x1B, 0x0B},
+        {0x5E, 0x9F, 0x56, 0x97, 0x46, 0x87, 0x66, 0xA7},
+        {0x41, 0x82, 0x61, 0xA2, 0x59, 0x9A, 0x49, 0x8A},
+    };
+    for(size_t rv = 0; rv < expectedRVStarts.size(); ++rv)
+    {
+        const auto& expected = expectedRVStarts[rv];
+        POTHOS_TEST_TRUE(expected == getLTERateMatchedIndices(blockSize, 192, rv, expected.size()));
+    }
+
+    // A 150-bit soft buffer limits Ncb to 150, so the redundancy versions
+    // start at k0 = 2 * ((20 * rv) + 2), and bit selection wraps around
+    // after w[149], to the first stream's sub-block.
+    POTHOS_TEST_EQUAL(150U, calcLTECircularBufferSize(blockSize, 1, 150));
+    POTHOS_TEST_EQUAL(75U, calcLTECircularBufferSize(blockSize, 2, 150));
+
+    const std::vector<std::uint8_t> expectedLimited =
+    {
+        0x4A, 0x8B, 0x6A, 0xAB, 0x4D, 0x8E, 0x5D, 0x9E,
+        0x55, 0x96, 0x45, 0x86, 0x65, 0xA6, 0x51, 0x92,
+        0x41, 0x82, 0x0C, 0x1C, 0x14, 0x04, 0x24, 0x10
+    };
+    POTHOS_TEST_TRUE(expectedLimited == getLTERateMatchedIndices(blockSize, 150, 3, expectedLimited.size()));
+}
+
+POTHOS_TEST_BLOCK("/fec/tests", test_lte_harq_combining_gain)
+{
+    const std::string blockStartID = "START";
+    const std::string harqID = "HARQ";
+    constexpr unsigned rgen = 013;
+    constexpr unsigned gen = 015;
+    constexpr size_t numIterations = 8;
+
+    // One code block of 1024 bits, sent at about rate 1/2 per transmission,
+    // at an SNR too low to decode a single transmission but not two.
+    constexpr size_t transportBlockSize = 1000;
+    constexpr size_t streamLength = 1024 + 4;
+    constexpr size_t numOutputBits = 2048;
+    constexpr float snr = 0.0f;
+    constexpr float amp = 16.0f;
+    const std::vector<size_t> rvs = {0, 2};
+
+    const auto input = getSeededRandomBits(transportBlockSize, 1);
+
+    auto encoder = Pothos::BlockRegistry::make("/fec/lte_turbo_encoder", rgen, gen);
+    encoder.call("setBlockStartID", blockStartID);
+    encoder.call("setTransportBlock", true);
+
+    auto bitFeederSource = Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8");
+    bitFeederSource.call("feedBuffer", input);
+    bitFeederSource.call("feedLabel", Pothos::Label(blockStartID, transportBlockSize, 0));
+
+    std::vector<Pothos::Proxy> rateMatchers;
+    std::vector<Pothos::Proxy> rateMatchedCollectorSinks;
+    for(const auto rv: rvs)
+    {
+        rateMatchers.emplace_back(Pothos::BlockRegistry::make("/fec/lte_rate_matcher"));
+        rateMatchers.back().call("setNumOutputBits", numOutputBits);
+        rateMatchers.back().call("setRV", rv);
+
+        rateMatchedCollectorSinks.emplace_back(Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8"));
+    }
+
+    {
+        Pothos::Topology topology;
+
+        topology.connect(bitFeederSource, 0, encoder, 0);
+        for(size_t i = 0; i < rvs.size(); ++i)
+        {
+            for(size_t port = 0; port < 3; ++port)
+            {
+                topology.connect(encoder, port, rateMatchers[i], port);
+            }
+            topology.connect(rateMatchers[i], 0, rateMatchedCollectorSinks[i], 0);
+        }
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+    }
+
+    // Send each redundancy version through its own noise, and de-rate-match
+    // it into the decoder's three streams.
+    std::srand(1);
+
+    std::vector<Pothos::Proxy> softFeederSources;
+    std::vector<Pothos::Proxy> rateDematchers;
+    std::vector<std::vector<Pothos::Proxy>> dematchedCollectorSinks(rvs.size());
+    for(size_t i = 0; i < rvs.size(); ++i)
+    {
+        const auto rateMatched = rateMatchedCollectorSinks[i].call<Pothos::BufferChunk>("getBuffer");
+        POTHOS_TEST_EQUAL(numOutputBits, rateMatched.elements());
+
+        int numBitsChanged = 0;
+        const auto softBits = FECTests::addNoiseAndGetError(rateMatched, snr, amp, &numBitsChanged);
+        POTHOS_TEST_TRUE(numBitsChanged > 0);
+
+        softFeederSources.emplace_back(Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8"));
+        softFeederSources.back().call("feedBuffer", softBits);
+        softFeederSources.back().call("feedLabel", Pothos::Label(blockStartID, transportBlockSize, 0));
+
+        rateDematchers.emplace_back(Pothos::BlockRegistry::make("/fec/lte_rate_dematcher"));
+        rateDematchers.back().call("setNumOutputBits", numOutputBits);
+        rateDematchers.back().call("setRV", rvs[i]);
+
+        for(size_t port = 0; port < 3; ++port)
+        {
+            dematchedCollectorSinks[i].emplace_back(Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8"));
+        }
+    }
+
+    {
+        Pothos::Topology topology;
+
+        for(size_t i = 0; i < rvs.size(); ++i)
+        {
+            topology.connect(softFeederSources[i], 0, rateDematchers[i], 0);
+            for(size_t port = 0; port < 3; ++port)
+            {
+                topology.connect(rateDematchers[i], port, dematchedCollectorSinks[i][port], 0);
+            }
+        }
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+    }
+
+    // Both transmissions go to the same HARQ process, one after the other,
+    // so the second transport block decoded is from their combined soft
+    // bits.
+    std::vector<Pothos::Proxy> combinedFeederSources;
+    for(size_t port = 0; port < 3; ++port)
+    {
+        Pothos::BufferChunk softBits("uint8", rvs.size() * streamLength);
+        for(size_t i = 0; i < rvs.size(); ++i)
+        {
+            const auto dematched = dematchedCollectorSinks[i][port].call<Pothos::BufferChunk>("getBuffer");
+            POTHOS_TEST_EQUAL(streamLength, dematched.elements());
+
+            std::copy(
+                dematched.as<const std::uint8_t*>(),
+                dematched.as<const std::uint8_t*>() + streamLength,
+                softBits.as<std::uint8_t*>() + (i * streamLength));
+        }
+
+        combinedFeederSources.emplace_back(Pothos::BlockRegistry::make("/blocks/feeder_source", "uint8"));
+        combinedFeederSources.back().call("feedBuffer", softBits);
+    }
+    for(size_t i = 0; i < rvs.size(); ++i)
+    {
+        const size_t index = i * streamLength;
+        combinedFeederSources[0].call("feedLabel", getHARQLabel(harqID, 0, rvs[i], (0 == i), streamLength, index));
+        combinedFeederSources[0].call("feedLabel", Pothos::Label(blockStartID, transportBlockSize, index));
+    }
+
+    auto combiner = Pothos::BlockRegistry::make("/fec/lte_harq_combiner");
+
+    auto decoder = Pothos::BlockRegistry::make("/fec/lte_turbo_decoder", numIterations, true);
+    decoder.call("setBlockStartID", blockStartID);
+    decoder.call("setTransportBlock", true);
+    decoder.call("setEarlyTermination", "CRC24A");
+
+    auto decodedCollectorSink = Pothos::BlockRegistry::make("/blocks/collector_sink", "uint8");
+
+    {
+        Pothos::Topology topology;
+
+        for(size_t port = 0; port < 3; ++port)
+        {
+            topology.connect(combinedFeederSources[port], 0, combiner, port);
+            topology.connect(combiner, port, decoder, port);
+        }
+        topology.connect(decoder, 0, decodedCollectorSink, 0);
+
+        topology.commit();
+        POTHOS_TEST_TRUE(topology.waitInactive(0.05));
+    }
+
+    const auto output = decodedCollectorSink.call<Pothos::BufferChunk>("getBuffer");
+    POTHOS_TEST_EQUAL(rvs.size() * transportBlockSize, output.elements());
+
+    const auto* inputBits = input.as<const std::uint8_t*>();
+    const auto* singleBits = output.as<const std::uint8_t*>();
+    const auto* combinedBits = singleBits + transportBlockSize;
+    POTHOS_TEST_TRUE(!std::equal(inputBits, inputBits + transportBlockSize, singleBits));
+    POTHOS_TEST_EQUALA(
+        inputBits,
+        combinedBits,
+        transportBlockSize);
+
+    // The single transmission ran every iteration without passing its CRC,
+    // so the combined one must have stopped early.
+    POTHOS_TEST_TRUE(decoder.call<double>("averageIterations") < numIterations);
+}